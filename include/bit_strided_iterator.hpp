@@ -0,0 +1,734 @@
+/**
+ * @file bit_strided_iterator.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus > 201703L
+#include <bit>
+#endif
+
+namespace bit_strided_detail{
+    using word_type = std::uint64_t;
+    constexpr std::ptrdiff_t word_bits = 64;
+
+    constexpr word_type low_mask(std::ptrdiff_t width) noexcept { return width >= word_bits ? ~word_type { } : (word_type { 1 } << width) - 1; }
+
+#if __cplusplus > 201703L
+    constexpr bool big_endian = std::endian::native == std::endian::big;
+#else
+    constexpr bool big_endian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+#endif
+
+    template <typename Word>
+    constexpr Word byteswap(Word word) noexcept {
+        Word swapped = 0;
+        for (std::size_t k = 0; k < sizeof(Word); ++k) swapped |= static_cast<Word>(((word >> (8 * k)) & 0xFF) << (8 * (sizeof(Word) - 1 - k)));
+        return swapped;
+    }
+
+    // Little-endian load/store of sizeof(Word) bytes: a single unaligned move (plus a byte swap on big-endian hosts).
+    template <typename Word>
+    Word load_little(const unsigned char* p) noexcept {
+        Word word;
+        std::memcpy(&word, p, sizeof(word));
+        if constexpr (big_endian) word = byteswap(word);
+        return word;
+    }
+    template <typename Word>
+    void store_little(unsigned char* p, Word word) noexcept {
+        if constexpr (big_endian) word = byteswap(word);
+        std::memcpy(p, &word, sizeof(word));
+    }
+    inline word_type load_word(const unsigned char* p) noexcept { return load_little<word_type>(p); }
+    inline void store_word(unsigned char* p, word_type word) noexcept { store_little(p, word); }
+
+    // Reads the field [bit, bit + width), touching only the bytes it covers.
+    inline word_type extract(const unsigned char* base, std::ptrdiff_t bit, std::ptrdiff_t width) noexcept {
+        const unsigned char* p = base + (bit >> 3);
+        const std::ptrdiff_t shift = bit & 7, byte_count = (shift + width + 7) / 8;
+        word_type word = 0;
+        for (std::ptrdiff_t k = 0; k < byte_count && k < 8; ++k) word |= word_type { p[k] } << (8 * k);
+        word >>= shift;
+        if (byte_count > 8) word |= word_type { p[8] } << (word_bits - shift);
+        return word & low_mask(width);
+    }
+
+    // Writes the field [bit, bit + width), leaving the neighbouring bits untouched.
+    inline void insert(unsigned char* base, std::ptrdiff_t bit, std::ptrdiff_t width, word_type value) noexcept {
+        unsigned char* p = base + (bit >> 3);
+        const std::ptrdiff_t shift = bit & 7, byte_count = (shift + width + 7) / 8;
+        const word_type mask = low_mask(width);
+        value &= mask;
+        for (std::ptrdiff_t k = 0; k < byte_count; ++k){
+            const auto byte_mask = static_cast<unsigned char>(k == 0 ? mask << shift : mask >> (8 * k - shift));
+            const auto byte_value = static_cast<unsigned char>(k == 0 ? value << shift : value >> (8 * k - shift));
+            p[k] = static_cast<unsigned char>((p[k] & ~byte_mask) | byte_value);
+        }
+    }
+
+    // Sign-extends \p raw if Tp is signed.
+    template <typename Tp>
+    constexpr Tp to_value(word_type raw, std::ptrdiff_t width) noexcept {
+        if constexpr (std::is_signed_v<Tp>){
+            if (width < word_bits && ((raw >> (width - 1)) & 1)) raw |= ~low_mask(width);
+        }
+        return static_cast<Tp>(raw);
+    }
+
+    // Extracts the fields k * BitStride (k in K) of \p word to dst[k], with constant shifts (a loop over k isn't unrolled at -O2).
+    template <std::ptrdiff_t BitWidth, std::ptrdiff_t BitStride, typename Tp, std::size_t... K>
+    void unpack_word(word_type word, Tp* dst, std::index_sequence<K...>) noexcept {
+        ((dst[K] = to_value<Tp>((word >> (K * BitStride)) & low_mask(BitWidth), BitWidth)), ...);
+    }
+
+    // Assembles src[k] (k in K) into the fields k * BitStride of a word, with constant shifts.
+    template <std::ptrdiff_t BitWidth, std::ptrdiff_t BitStride, typename Tp, std::size_t... K>
+    word_type pack_word(const Tp* src, std::index_sequence<K...>) noexcept {
+        return (word_type { } | ... | ((static_cast<word_type>(src[K]) & low_mask(BitWidth)) << (K * BitStride)));
+    }
+
+    // Packs the leading fields a destination word at a time: each 8-byte word touched by a field is loaded once, receives all of its fields
+    // and is stored once, so a field never waits for the store of the previous one. Only the fields whose words lie inside the buffer spanned
+    // by the \p count fields are packed, and their number is returned. Requires 0 < bit_width <= 64 and bit_width <= bit_stride.
+    // Non-zero \p BitWidth and \p BitStride replace bit_width and bit_stride by constants.
+    template <std::ptrdiff_t BitWidth = 0, std::ptrdiff_t BitStride = 0, typename Tp>
+    std::size_t pack_words(const Tp* src, std::size_t count, unsigned char* bytes, std::ptrdiff_t bit_offset, std::ptrdiff_t bit_width, std::ptrdiff_t bit_stride) noexcept {
+        if constexpr (BitWidth != 0) bit_width = BitWidth;
+        if constexpr (BitStride != 0) bit_stride = BitStride;
+        if (count == 0) return 0;
+        unsigned char* base = bytes + (bit_offset >> 3);
+        const std::ptrdiff_t first = bit_offset & 7;
+        const std::ptrdiff_t end_byte = (first + static_cast<std::ptrdiff_t>(count - 1) * bit_stride + bit_width + 7) >> 3;
+        // The last field start whose words end inside the buffer.
+        const std::ptrdiff_t last_bit = (end_byte >> 3) * word_bits - bit_width;
+        if (last_bit < first) return 0;
+        const std::size_t safe = std::min(count, static_cast<std::size_t>((last_bit - first) / bit_stride) + 1);
+
+        const word_type mask = low_mask(bit_width);
+        std::ptrdiff_t index = 0;
+        word_type word = load_word(base);
+        for (std::size_t i = 0; i < safe; ++i){
+            const std::ptrdiff_t bit = first + static_cast<std::ptrdiff_t>(i) * bit_stride, shift = bit & (word_bits - 1);
+            if ((bit >> 6) != index){
+                store_word(base + 8 * index, word);
+                index = bit >> 6;
+                word = load_word(base + 8 * index);
+            }
+            const word_type value = static_cast<word_type>(src[i]) & mask;
+            word = (word & ~(mask << shift)) | (value << shift);
+            if (shift + bit_width > word_bits){
+                store_word(base + 8 * index, word);
+                ++index;
+                word = (load_word(base + 8 * index) & ~low_mask(shift + bit_width - word_bits)) | (value >> (word_bits - shift));
+            }
+        }
+        store_word(base + 8 * index, word);
+        return safe;
+    }
+
+    // Number of leading fields whose whole \p window_bytes window lies inside the buffer spanned by \p count fields.
+    inline std::size_t word_safe_count(std::ptrdiff_t bit_offset, std::size_t count, std::ptrdiff_t bit_stride, std::ptrdiff_t bit_width, std::ptrdiff_t window_bytes = 8) noexcept {
+        if (count == 0) return 0;
+        const std::ptrdiff_t end_byte = (bit_offset + static_cast<std::ptrdiff_t>(count - 1) * bit_stride + bit_width + 7) >> 3;
+        std::size_t safe = count;
+        while (safe > 0 && ((bit_offset + static_cast<std::ptrdiff_t>(safe - 1) * bit_stride) >> 3) + window_bytes > end_byte) --safe;
+        return safe;
+    }
+
+    // Number of bytes a field may span. If the stride is a whole number of bytes, every field has the bit shift of the first one.
+    constexpr std::ptrdiff_t field_span(std::ptrdiff_t bit_offset, std::ptrdiff_t bit_width, std::ptrdiff_t bit_stride) noexcept {
+        return bit_stride % 8 == 0 ? ((bit_offset & 7) + bit_width + 7) / 8 : (bit_width + 7 + 7) / 8;
+    }
+
+    // Smallest load/store size (1, 2, 4 or 8 bytes) of at least \p span bytes, 0 if 8 bytes are too few.
+    constexpr std::ptrdiff_t window_size(std::ptrdiff_t span) noexcept {
+        return span <= 1 ? 1 : span <= 2 ? 2 : span <= 4 ? 4 : span <= 8 ? 8 : 0;
+    }
+
+    template <std::ptrdiff_t WindowSize>
+    using window_type = std::conditional_t<WindowSize == 1, std::uint8_t, std::conditional_t<WindowSize == 2, std::uint16_t,
+                        std::conditional_t<WindowSize == 4, std::uint32_t, std::uint64_t>>>;
+
+    // Packs the leading fields of a layout whose consecutive \p WindowSize byte windows never overlap, each with a single load and store of its window.
+    // The windows don't overlap, so no store waits for the previous one, and fewer bytes are touched than by a word per field. Only the fields
+    // whose windows lie inside the buffer spanned by the \p count fields are packed, and their number is returned.
+    // Non-zero \p BitWidth and \p BitStride replace bit_width and bit_stride by constants.
+    template <std::ptrdiff_t WindowSize, std::ptrdiff_t BitWidth = 0, std::ptrdiff_t BitStride = 0, typename Tp>
+    std::size_t pack_windows(const Tp* src, std::size_t count, unsigned char* bytes, std::ptrdiff_t bit_offset, std::ptrdiff_t bit_width, std::ptrdiff_t bit_stride) noexcept {
+        using window = window_type<WindowSize>;
+        if constexpr (BitWidth != 0) bit_width = BitWidth;
+        if constexpr (BitStride != 0) bit_stride = BitStride;
+
+        const std::size_t safe = word_safe_count(bit_offset, count, bit_stride, bit_width, WindowSize);
+        const word_type mask = low_mask(bit_width);
+        if (bit_stride % 8 == 0){
+            // Every field has the same bit shift, so the windows are just stepped through.
+            const std::ptrdiff_t shift = bit_offset & 7, step = bit_stride / 8;
+            const auto field_mask = static_cast<window>(mask << shift);
+            unsigned char* p = bytes + (bit_offset >> 3);
+            for (std::size_t i = 0; i < safe; ++i, p += step){
+                store_little(p, static_cast<window>((load_little<window>(p) & ~field_mask) | ((static_cast<window>(src[i]) << shift) & field_mask)));
+            }
+            return safe;
+        }
+        for (std::size_t i = 0; i < safe; ++i){
+            const std::ptrdiff_t bit = bit_offset + static_cast<std::ptrdiff_t>(i) * bit_stride, shift = bit & 7;
+            unsigned char* p = bytes + (bit >> 3);
+            const word_type value = (static_cast<word_type>(src[i]) & mask) << shift;
+            store_little(p, static_cast<window>((load_little<window>(p) & ~(mask << shift)) | value));
+        }
+        return safe;
+    }
+
+    // Packs the leading fields with pack_windows if the windows of consecutive fields can't overlap (sparse fields), otherwise with
+    // pack_words, and returns their number. Requires 0 < bit_width <= 64 and bit_width <= bit_stride.
+    template <std::ptrdiff_t BitWidth = 0, std::ptrdiff_t BitStride = 0, typename Tp>
+    std::size_t pack_fields(const Tp* src, std::size_t count, unsigned char* bytes, std::ptrdiff_t bit_offset, std::ptrdiff_t bit_width, std::ptrdiff_t bit_stride) noexcept {
+        const std::ptrdiff_t window = window_size(field_span(bit_offset, bit_width, bit_stride));
+        if (window == 0 || bit_stride / 8 < window) return pack_words<BitWidth, BitStride>(src, count, bytes, bit_offset, bit_width, bit_stride);
+        switch (window){
+            case 1: return pack_windows<1, BitWidth, BitStride>(src, count, bytes, bit_offset, bit_width, bit_stride);
+            case 2: return pack_windows<2, BitWidth, BitStride>(src, count, bytes, bit_offset, bit_width, bit_stride);
+            case 4: return pack_windows<4, BitWidth, BitStride>(src, count, bytes, bit_offset, bit_width, bit_stride);
+            default: return pack_windows<8, BitWidth, BitStride>(src, count, bytes, bit_offset, bit_width, bit_stride);
+        }
+    }
+}
+
+template <typename Tp, std::ptrdiff_t...> struct bit_reference;
+
+/**
+ * @brief A proxy reference to a bit field of width \p BitWidth.
+ *
+ * @tparam Tp Type of the unpacked value. If it is signed, the field is sign-extended on read.
+ * @tparam BitWidth Bit width of the field
+ */
+template <typename Tp, std::ptrdiff_t BitWidth>
+struct bit_reference<Tp, BitWidth>{
+private:
+    unsigned char* _base;
+    std::ptrdiff_t _bit;
+
+public:
+    bit_reference(unsigned char* base, std::ptrdiff_t bit) noexcept : _base { base }, _bit { bit } { }
+    bit_reference(const bit_reference&) noexcept = default;
+
+    operator Tp() const noexcept { return bit_strided_detail::to_value<Tp>(bit_strided_detail::extract(_base, _bit, BitWidth), BitWidth); }
+
+    // Assignments write through the proxy, so they are const like std::vector<bool>::reference.
+    const bit_reference& operator=(Tp value) const noexcept { bit_strided_detail::insert(_base, _bit, BitWidth, static_cast<bit_strided_detail::word_type>(value)); return *this; }
+    const bit_reference& operator=(const bit_reference& other) const noexcept { return *this = static_cast<Tp>(other); }
+
+    // Swaps the referenced fields (or a field and a value), like std::vector<bool>::reference, so swapping algorithms work on the iterators.
+    friend void swap(const bit_reference& left, const bit_reference& right) noexcept { const Tp temp = left; left = static_cast<Tp>(right); right = temp; }
+    friend void swap(const bit_reference& left, Tp& right) noexcept { const Tp temp = left; left = right; right = temp; }
+    friend void swap(Tp& left, const bit_reference& right) noexcept { const Tp temp = left; left = static_cast<Tp>(right); right = temp; }
+};
+
+/**
+ * @brief A proxy reference to a bit field whose width is known at runtime.
+ *
+ * @tparam Tp Type of the unpacked value. If it is signed, the field is sign-extended on read.
+ */
+template <typename Tp>
+struct bit_reference<Tp>{
+private:
+    unsigned char* _base;
+    std::ptrdiff_t _bit;
+    std::ptrdiff_t _bit_width;
+
+public:
+    bit_reference(unsigned char* base, std::ptrdiff_t bit, std::ptrdiff_t bit_width) noexcept : _base { base }, _bit { bit }, _bit_width { bit_width } { }
+    bit_reference(const bit_reference&) noexcept = default;
+
+    operator Tp() const noexcept { return bit_strided_detail::to_value<Tp>(bit_strided_detail::extract(_base, _bit, _bit_width), _bit_width); }
+
+    const bit_reference& operator=(Tp value) const noexcept { bit_strided_detail::insert(_base, _bit, _bit_width, static_cast<bit_strided_detail::word_type>(value)); return *this; }
+    const bit_reference& operator=(const bit_reference& other) const noexcept { return *this = static_cast<Tp>(other); }
+
+    friend void swap(const bit_reference& left, const bit_reference& right) noexcept { const Tp temp = left; left = static_cast<Tp>(right); right = temp; }
+    friend void swap(const bit_reference& left, Tp& right) noexcept { const Tp temp = left; left = right; right = temp; }
+    friend void swap(Tp& left, const bit_reference& right) noexcept { const Tp temp = left; left = static_cast<Tp>(right); right = temp; }
+};
+
+template <typename Tp, std::ptrdiff_t...> struct bit_strided_iterator;
+
+/**
+ * @brief An iterator over bit-packed fields: the n-th field occupies bits [n * BitStride, n * BitStride + BitWidth) from the origin.
+ *
+ * @tparam Tp Integral type of the unpacked value
+ * @tparam BitWidth Bit width of each field (1 to 64, at most the width of \p Tp)
+ * @tparam BitStride Distance in bits between the start of consecutive fields
+ *
+ * @note Bits are numbered LSB first inside each byte, and bytes in the increasing address order, i.e. the layout of a little-endian bit stream.
+ * Dereferencing returns a bit_reference proxy which converts to/assigns from \p Tp, so the iterator is std::random_access_iterator but never contiguous.
+ * If \p BitStride is negative, it goes backward.
+ */
+template <typename Tp, std::ptrdiff_t BitWidth, std::ptrdiff_t BitStride>
+struct bit_strided_iterator<Tp, BitWidth, BitStride>{
+    static_assert(std::is_integral_v<Tp>, "bit_strided_iterator<Tp, BitWidth, BitStride> requires integral Tp.");
+    static_assert(BitWidth > 0 && BitWidth <= bit_strided_detail::word_bits && BitWidth <= static_cast<std::ptrdiff_t>(sizeof(Tp) * CHAR_BIT), "BitWidth must fit in both Tp and 64 bits.");
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = Tp;
+    using pointer = void;
+    using reference = bit_reference<Tp, BitWidth>;
+    using difference_type = std::ptrdiff_t;
+
+    using self_type = bit_strided_iterator<Tp, BitWidth, BitStride>;
+
+private:
+    unsigned char* _base;
+    difference_type _bit;
+
+public:
+    // Constructors
+    bit_strided_iterator() noexcept : _base { }, _bit { } { }
+    bit_strided_iterator(void* base, difference_type bit_offset = 0) noexcept : _base { static_cast<unsigned char*>(base) }, _bit { bit_offset } { }
+    bit_strided_iterator(const self_type& source) noexcept : _base { source._base }, _bit { source._bit } { }
+
+    self_type& operator=(const self_type& iterator) noexcept { _base = iterator._base; _bit = iterator._bit; return *this; }
+
+    // Accessors
+    unsigned char* base() const noexcept { return _base; }
+    difference_type bit_offset() const noexcept { return _bit; }
+
+    // Tp* like operators
+    reference operator*() const noexcept { return reference { _base, _bit }; }
+    reference operator[](difference_type n) const noexcept { return reference { _base, _bit + n * BitStride }; }
+
+    // Increment / Decrement
+    self_type& operator++() noexcept { _bit += BitStride; return *this; }
+    self_type operator++(int) noexcept { self_type temp { *this }; ++(*this); return temp; }
+    self_type& operator--() noexcept { _bit -= BitStride; return *this; }
+    self_type operator--(int) noexcept { self_type temp { *this }; --(*this); return temp; }
+
+    // Arithmetic
+    self_type& operator+=(difference_type n) noexcept { _bit += n * BitStride; return *this; }
+    self_type& operator-=(difference_type n) noexcept { _bit -= n * BitStride; return *this; }
+    friend self_type operator+(const self_type& iter, difference_type n) noexcept { self_type temp { iter }; temp += n; return temp; }
+    friend self_type operator+(difference_type n, self_type right) noexcept { right += n; return right; }
+    friend self_type operator-(self_type left, difference_type n) noexcept { left -= n; return left; }
+
+    // Difference
+    friend difference_type operator-(const self_type& left, const self_type& right) noexcept { return ((left._base - right._base) * CHAR_BIT + left._bit - right._bit) / BitStride; }
+
+    // Comparison operators (by the absolute bit position, so iterators with different origins in the same buffer compare correctly)
+    friend bool operator==(const self_type& left, const self_type& right) noexcept { return compare(left, right) == 0; }
+    friend bool operator!=(const self_type& left, const self_type& right) noexcept { return compare(left, right) != 0; }
+    friend bool operator<(const self_type& left, const self_type& right) noexcept { return compare(left, right) < 0; }
+    friend bool operator<=(const self_type& left, const self_type& right) noexcept { return compare(left, right) <= 0; }
+    friend bool operator>(const self_type& left, const self_type& right) noexcept { return compare(left, right) > 0; }
+    friend bool operator>=(const self_type& left, const self_type& right) noexcept { return compare(left, right) >= 0; }
+
+private:
+    static difference_type compare(const self_type& left, const self_type& right) noexcept { return (left._base - right._base) * CHAR_BIT + left._bit - right._bit; }
+};
+
+/**
+ * @brief An iterator over bit-packed fields whose width and stride are known at runtime.
+ *
+ * @tparam Tp Integral type of the unpacked value
+ *
+ * @note The bit width must be in [1, 64] and at most the width of \p Tp, like BitWidth of bit_strided_iterator<Tp, BitWidth, BitStride>;
+ * it is not checked. If the width and stride are known at the compile time, it is recomended to use
+ * bit_strided_iterator<Tp, BitWidth, BitStride> because it has less overhead.
+ */
+template <typename Tp>
+struct bit_strided_iterator<Tp>{
+    static_assert(std::is_integral_v<Tp>, "bit_strided_iterator<Tp> requires integral Tp.");
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = Tp;
+    using pointer = void;
+    using reference = bit_reference<Tp>;
+    using difference_type = std::ptrdiff_t;
+
+    using self_type = bit_strided_iterator<Tp>;
+
+private:
+    unsigned char* _base;
+    difference_type _bit;
+    difference_type _bit_width;
+    difference_type _bit_stride;
+
+public:
+    // Constructors
+    bit_strided_iterator(difference_type bit_width = sizeof(Tp) * CHAR_BIT, difference_type bit_stride = sizeof(Tp) * CHAR_BIT) noexcept
+        : _base { }, _bit { }, _bit_width { bit_width }, _bit_stride { bit_stride } { }
+    bit_strided_iterator(void* base, difference_type bit_width, difference_type bit_stride, difference_type bit_offset = 0) noexcept
+        : _base { static_cast<unsigned char*>(base) }, _bit { bit_offset }, _bit_width { bit_width }, _bit_stride { bit_stride } { }
+    bit_strided_iterator(const self_type& source) noexcept
+        : _base { source._base }, _bit { source._bit }, _bit_width { source._bit_width }, _bit_stride { source._bit_stride } { }
+
+    self_type& operator=(const self_type& iterator) noexcept { _base = iterator._base; _bit = iterator._bit; _bit_width = iterator._bit_width; _bit_stride = iterator._bit_stride; return *this; }
+
+    // Accessors
+    unsigned char* base() const noexcept { return _base; }
+    difference_type bit_offset() const noexcept { return _bit; }
+    difference_type bit_width() const noexcept { return _bit_width; }
+    difference_type bit_stride() const noexcept { return _bit_stride; }
+
+    // Tp* like operators
+    reference operator*() const noexcept { return reference { _base, _bit, _bit_width }; }
+    reference operator[](difference_type n) const noexcept { return reference { _base, _bit + n * _bit_stride, _bit_width }; }
+
+    // Increment / Decrement
+    self_type& operator++() noexcept { _bit += _bit_stride; return *this; }
+    self_type operator++(int) noexcept { self_type temp { *this }; ++(*this); return temp; }
+    self_type& operator--() noexcept { _bit -= _bit_stride; return *this; }
+    self_type operator--(int) noexcept { self_type temp { *this }; --(*this); return temp; }
+
+    // Arithmetic
+    self_type& operator+=(difference_type n) noexcept { _bit += n * _bit_stride; return *this; }
+    self_type& operator-=(difference_type n) noexcept { _bit -= n * _bit_stride; return *this; }
+    friend self_type operator+(const self_type& iter, difference_type n) noexcept { self_type temp { iter }; temp += n; return temp; }
+    friend self_type operator+(difference_type n, self_type right) noexcept { right += n; return right; }
+    friend self_type operator-(self_type left, difference_type n) noexcept { left -= n; return left; }
+
+    // Difference
+    friend difference_type operator-(const self_type& left, const self_type& right) {
+#ifndef NDEBUG
+        if (left._bit_width != right._bit_width || left._bit_stride != right._bit_stride){
+            throw std::runtime_error { "bit_strided_iterator<Tp> subtract operation with different bit widths or strides." };
+        }
+#endif
+        return compare(left, right) / left._bit_stride;
+    }
+
+    // Comparison operators
+    friend bool operator==(const self_type& left, const self_type& right) noexcept { return compare(left, right) == 0; }
+    friend bool operator!=(const self_type& left, const self_type& right) noexcept { return compare(left, right) != 0; }
+    friend bool operator<(const self_type& left, const self_type& right) noexcept { return compare(left, right) < 0; }
+    friend bool operator<=(const self_type& left, const self_type& right) noexcept { return compare(left, right) <= 0; }
+    friend bool operator>(const self_type& left, const self_type& right) noexcept { return compare(left, right) > 0; }
+    friend bool operator>=(const self_type& left, const self_type& right) noexcept { return compare(left, right) >= 0; }
+
+private:
+    static difference_type compare(const self_type& left, const self_type& right) noexcept { return (left._base - right._base) * CHAR_BIT + left._bit - right._bit; }
+};
+
+template <typename Tp, std::ptrdiff_t...> struct const_bit_strided_iterator;
+
+/**
+ * @brief A read-only bit_strided_iterator<Tp, BitWidth, BitStride>, over a const buffer. Dereferencing returns the field value.
+ */
+template <typename Tp, std::ptrdiff_t BitWidth, std::ptrdiff_t BitStride>
+struct const_bit_strided_iterator<Tp, BitWidth, BitStride>{
+    static_assert(std::is_integral_v<Tp>, "const_bit_strided_iterator<Tp, BitWidth, BitStride> requires integral Tp.");
+    static_assert(BitWidth > 0 && BitWidth <= bit_strided_detail::word_bits && BitWidth <= static_cast<std::ptrdiff_t>(sizeof(Tp) * CHAR_BIT), "BitWidth must fit in both Tp and 64 bits.");
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = Tp;
+    using pointer = void;
+    using reference = Tp;
+    using difference_type = std::ptrdiff_t;
+
+    using self_type = const_bit_strided_iterator<Tp, BitWidth, BitStride>;
+
+private:
+    const unsigned char* _base;
+    difference_type _bit;
+
+public:
+    // Constructors
+    const_bit_strided_iterator() noexcept : _base { }, _bit { } { }
+    const_bit_strided_iterator(const void* base, difference_type bit_offset = 0) noexcept : _base { static_cast<const unsigned char*>(base) }, _bit { bit_offset } { }
+    const_bit_strided_iterator(const bit_strided_iterator<Tp, BitWidth, BitStride>& iterator) noexcept : _base { iterator.base() }, _bit { iterator.bit_offset() } { }
+    const_bit_strided_iterator(const self_type& source) noexcept : _base { source._base }, _bit { source._bit } { }
+
+    self_type& operator=(const self_type& iterator) noexcept { _base = iterator._base; _bit = iterator._bit; return *this; }
+
+    // Accessors
+    const unsigned char* base() const noexcept { return _base; }
+    difference_type bit_offset() const noexcept { return _bit; }
+
+    // Tp* like operators
+    reference operator*() const noexcept { return load(_bit); }
+    reference operator[](difference_type n) const noexcept { return load(_bit + n * BitStride); }
+
+    // Increment / Decrement
+    self_type& operator++() noexcept { _bit += BitStride; return *this; }
+    self_type operator++(int) noexcept { self_type temp { *this }; ++(*this); return temp; }
+    self_type& operator--() noexcept { _bit -= BitStride; return *this; }
+    self_type operator--(int) noexcept { self_type temp { *this }; --(*this); return temp; }
+
+    // Arithmetic
+    self_type& operator+=(difference_type n) noexcept { _bit += n * BitStride; return *this; }
+    self_type& operator-=(difference_type n) noexcept { _bit -= n * BitStride; return *this; }
+    friend self_type operator+(const self_type& iter, difference_type n) noexcept { self_type temp { iter }; temp += n; return temp; }
+    friend self_type operator+(difference_type n, self_type right) noexcept { right += n; return right; }
+    friend self_type operator-(self_type left, difference_type n) noexcept { left -= n; return left; }
+
+    // Difference
+    friend difference_type operator-(const self_type& left, const self_type& right) noexcept { return compare(left, right) / BitStride; }
+
+    // Comparison operators
+    friend bool operator==(const self_type& left, const self_type& right) noexcept { return compare(left, right) == 0; }
+    friend bool operator!=(const self_type& left, const self_type& right) noexcept { return compare(left, right) != 0; }
+    friend bool operator<(const self_type& left, const self_type& right) noexcept { return compare(left, right) < 0; }
+    friend bool operator<=(const self_type& left, const self_type& right) noexcept { return compare(left, right) <= 0; }
+    friend bool operator>(const self_type& left, const self_type& right) noexcept { return compare(left, right) > 0; }
+    friend bool operator>=(const self_type& left, const self_type& right) noexcept { return compare(left, right) >= 0; }
+
+private:
+    Tp load(difference_type bit) const noexcept { return bit_strided_detail::to_value<Tp>(bit_strided_detail::extract(_base, bit, BitWidth), BitWidth); }
+    static difference_type compare(const self_type& left, const self_type& right) noexcept { return (left._base - right._base) * CHAR_BIT + left._bit - right._bit; }
+};
+
+/**
+ * @brief A read-only bit_strided_iterator<Tp>, over a const buffer. Dereferencing returns the field value.
+ *
+ * @note If the width and stride are known at the compile time, it is recomended to use const_bit_strided_iterator<Tp, BitWidth, BitStride>
+ * because it has less overhead.
+ */
+template <typename Tp>
+struct const_bit_strided_iterator<Tp>{
+    static_assert(std::is_integral_v<Tp>, "const_bit_strided_iterator<Tp> requires integral Tp.");
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = Tp;
+    using pointer = void;
+    using reference = Tp;
+    using difference_type = std::ptrdiff_t;
+
+    using self_type = const_bit_strided_iterator<Tp>;
+
+private:
+    const unsigned char* _base;
+    difference_type _bit;
+    difference_type _bit_width;
+    difference_type _bit_stride;
+
+public:
+    // Constructors
+    const_bit_strided_iterator(difference_type bit_width = sizeof(Tp) * CHAR_BIT, difference_type bit_stride = sizeof(Tp) * CHAR_BIT) noexcept
+        : _base { }, _bit { }, _bit_width { bit_width }, _bit_stride { bit_stride } { }
+    const_bit_strided_iterator(const void* base, difference_type bit_width, difference_type bit_stride, difference_type bit_offset = 0) noexcept
+        : _base { static_cast<const unsigned char*>(base) }, _bit { bit_offset }, _bit_width { bit_width }, _bit_stride { bit_stride } { }
+    const_bit_strided_iterator(const bit_strided_iterator<Tp>& iterator) noexcept
+        : _base { iterator.base() }, _bit { iterator.bit_offset() }, _bit_width { iterator.bit_width() }, _bit_stride { iterator.bit_stride() } { }
+    const_bit_strided_iterator(const self_type& source) noexcept
+        : _base { source._base }, _bit { source._bit }, _bit_width { source._bit_width }, _bit_stride { source._bit_stride } { }
+
+    self_type& operator=(const self_type& iterator) noexcept { _base = iterator._base; _bit = iterator._bit; _bit_width = iterator._bit_width; _bit_stride = iterator._bit_stride; return *this; }
+
+    // Accessors
+    const unsigned char* base() const noexcept { return _base; }
+    difference_type bit_offset() const noexcept { return _bit; }
+    difference_type bit_width() const noexcept { return _bit_width; }
+    difference_type bit_stride() const noexcept { return _bit_stride; }
+
+    // Tp* like operators
+    reference operator*() const noexcept { return load(_bit); }
+    reference operator[](difference_type n) const noexcept { return load(_bit + n * _bit_stride); }
+
+    // Increment / Decrement
+    self_type& operator++() noexcept { _bit += _bit_stride; return *this; }
+    self_type operator++(int) noexcept { self_type temp { *this }; ++(*this); return temp; }
+    self_type& operator--() noexcept { _bit -= _bit_stride; return *this; }
+    self_type operator--(int) noexcept { self_type temp { *this }; --(*this); return temp; }
+
+    // Arithmetic
+    self_type& operator+=(difference_type n) noexcept { _bit += n * _bit_stride; return *this; }
+    self_type& operator-=(difference_type n) noexcept { _bit -= n * _bit_stride; return *this; }
+    friend self_type operator+(const self_type& iter, difference_type n) noexcept { self_type temp { iter }; temp += n; return temp; }
+    friend self_type operator+(difference_type n, self_type right) noexcept { right += n; return right; }
+    friend self_type operator-(self_type left, difference_type n) noexcept { left -= n; return left; }
+
+    // Difference
+    friend difference_type operator-(const self_type& left, const self_type& right) {
+#ifndef NDEBUG
+        if (left._bit_width != right._bit_width || left._bit_stride != right._bit_stride){
+            throw std::runtime_error { "const_bit_strided_iterator<Tp> subtract operation with different bit widths or strides." };
+        }
+#endif
+        return compare(left, right) / left._bit_stride;
+    }
+
+    // Comparison operators
+    friend bool operator==(const self_type& left, const self_type& right) noexcept { return compare(left, right) == 0; }
+    friend bool operator!=(const self_type& left, const self_type& right) noexcept { return compare(left, right) != 0; }
+    friend bool operator<(const self_type& left, const self_type& right) noexcept { return compare(left, right) < 0; }
+    friend bool operator<=(const self_type& left, const self_type& right) noexcept { return compare(left, right) <= 0; }
+    friend bool operator>(const self_type& left, const self_type& right) noexcept { return compare(left, right) > 0; }
+    friend bool operator>=(const self_type& left, const self_type& right) noexcept { return compare(left, right) >= 0; }
+
+private:
+    Tp load(difference_type bit) const noexcept { return bit_strided_detail::to_value<Tp>(bit_strided_detail::extract(_base, bit, _bit_width), _bit_width); }
+    static difference_type compare(const self_type& left, const self_type& right) noexcept { return (left._base - right._base) * CHAR_BIT + left._bit - right._bit; }
+};
+
+/**
+ * @brief Unpacks \p count bit fields into \p dst.
+ *
+ * @tparam Tp Integral type of the unpacked value
+ * @tparam BitWidth Bit width of each field (1 to 64, at most the width of \p Tp)
+ * @tparam BitStride Distance in bits between consecutive fields (must be positive)
+ * @param src Origin of the packed buffer
+ * @param count Number of fields to unpack
+ * @param dst Destination of \p count values
+ * @param bit_offset Bit position of the first field from \p src
+ *
+ * @note If \p BitStride divides 64 and the first field is byte aligned, each 64-bit word is loaded once and all fields inside it are
+ * extracted with constant shifts (the fields of a word are expanded at compile time). Otherwise every field takes one unaligned word load.
+ * Only the bytes spanned by the fields are read.
+ */
+template <typename Tp, std::ptrdiff_t BitWidth, std::ptrdiff_t BitStride>
+void bit_unpack(const void* src, std::size_t count, Tp* dst, std::ptrdiff_t bit_offset = 0) noexcept {
+    using namespace bit_strided_detail;
+    static_assert(BitStride > 0, "bit_unpack requires positive BitStride.");
+    static_assert(BitWidth > 0 && BitWidth <= word_bits && BitWidth <= static_cast<std::ptrdiff_t>(sizeof(Tp) * CHAR_BIT), "BitWidth must fit in both Tp and 64 bits.");
+
+    const auto* bytes = static_cast<const unsigned char*>(src);
+    std::size_t i = 0;
+
+    if constexpr (word_bits % BitStride == 0 && BitWidth <= BitStride){
+        constexpr std::size_t per_word = word_bits / BitStride;
+        // The last word is only loaded whole if its last field reaches its last byte, otherwise it could lie past the buffer.
+        constexpr bool fills_word = static_cast<std::ptrdiff_t>(per_word - 1) * BitStride + BitWidth > word_bits - 8;
+        const std::size_t block_count = fills_word || count == 0 ? count : count - 1;
+        if ((bit_offset & 7) == 0){
+            const unsigned char* word_ptr = bytes + (bit_offset >> 3);
+            for (; i + per_word <= block_count; i += per_word, word_ptr += 8){
+                unpack_word<BitWidth, BitStride>(load_word(word_ptr), dst + i, std::make_index_sequence<per_word> { });
+            }
+        }
+    }
+    if constexpr (BitWidth <= word_bits - 7){
+        const std::size_t safe = i + word_safe_count(bit_offset + static_cast<std::ptrdiff_t>(i) * BitStride, count - i, BitStride, BitWidth);
+        for (; i < safe; ++i){
+            const std::ptrdiff_t bit = bit_offset + static_cast<std::ptrdiff_t>(i) * BitStride;
+            dst[i] = to_value<Tp>((load_word(bytes + (bit >> 3)) >> (bit & 7)) & low_mask(BitWidth), BitWidth);
+        }
+    }
+    for (; i < count; ++i){
+        dst[i] = to_value<Tp>(extract(bytes, bit_offset + static_cast<std::ptrdiff_t>(i) * BitStride, BitWidth), BitWidth);
+    }
+}
+
+/**
+ * @brief Unpacks \p count bit fields whose width and stride are known at runtime into \p dst.
+ *
+ * @note \p bit_width must be in [1, 64] and at most the width of \p Tp; it is not checked. It is recomended to use
+ * bit_unpack<Tp, BitWidth, BitStride> if the layout is known at the compile time.
+ */
+template <typename Tp>
+void bit_unpack(const void* src, std::size_t count, Tp* dst, std::ptrdiff_t bit_width, std::ptrdiff_t bit_stride, std::ptrdiff_t bit_offset = 0) noexcept {
+    using namespace bit_strided_detail;
+
+    const auto* bytes = static_cast<const unsigned char*>(src);
+    std::size_t i = 0;
+
+    if (bit_width <= word_bits - 7){
+        const word_type mask = low_mask(bit_width);
+        const std::size_t safe = word_safe_count(bit_offset, count, bit_stride, bit_width);
+        if (bit_stride % 8 == 0){
+            // Every field has the same bit shift, so the words are just stepped through.
+            const std::ptrdiff_t shift = bit_offset & 7, step = bit_stride / 8;
+            const unsigned char* p = bytes + (bit_offset >> 3);
+            for (; i < safe; ++i, p += step){
+                dst[i] = to_value<Tp>((load_word(p) >> shift) & mask, bit_width);
+            }
+        }
+        for (; i < safe; ++i){
+            const std::ptrdiff_t bit = bit_offset + static_cast<std::ptrdiff_t>(i) * bit_stride;
+            dst[i] = to_value<Tp>((load_word(bytes + (bit >> 3)) >> (bit & 7)) & mask, bit_width);
+        }
+    }
+    for (; i < count; ++i){
+        dst[i] = to_value<Tp>(extract(bytes, bit_offset + static_cast<std::ptrdiff_t>(i) * bit_stride, bit_width), bit_width);
+    }
+}
+
+/**
+ * @brief Packs \p count values from \p src into bit fields. Bits outside the fields are preserved.
+ *
+ * @tparam Tp Integral type of the unpacked value
+ * @tparam BitWidth Bit width of each field (1 to 64, at most the width of \p Tp; values are truncated to it)
+ * @tparam BitStride Distance in bits between consecutive fields (must not be less than \p BitWidth)
+ * @param src Source of \p count values
+ * @param count Number of fields to pack
+ * @param dst Origin of the packed buffer
+ * @param bit_offset Bit position of the first field from \p dst
+ *
+ * @note If \p BitStride divides 64 and the first field is byte aligned, each 64-bit word is assembled in a register with constant shifts
+ * and stored once. Sparse fields, whose 1, 2, 4 or 8-byte windows can't overlap, are each written with a single load and store of their
+ * window. Otherwise each destination word is loaded once, receives all the fields it holds and is stored once. Only the bytes spanned
+ * by the fields are written.
+ */
+template <typename Tp, std::ptrdiff_t BitWidth, std::ptrdiff_t BitStride>
+void bit_pack(const Tp* src, std::size_t count, void* dst, std::ptrdiff_t bit_offset = 0) noexcept {
+    using namespace bit_strided_detail;
+    static_assert(BitWidth > 0 && BitWidth <= word_bits && BitWidth <= static_cast<std::ptrdiff_t>(sizeof(Tp) * CHAR_BIT), "BitWidth must fit in both Tp and 64 bits.");
+    static_assert(BitStride >= BitWidth, "bit_pack requires non-overlapping fields.");
+
+    auto* bytes = static_cast<unsigned char*>(dst);
+    std::size_t i = 0;
+
+    if constexpr (word_bits % BitStride == 0){
+        constexpr std::size_t per_word = word_bits / BitStride;
+        constexpr bool fills_word = static_cast<std::ptrdiff_t>(per_word - 1) * BitStride + BitWidth > word_bits - 8;
+        const std::size_t block_count = fills_word || count == 0 ? count : count - 1;
+        if ((bit_offset & 7) == 0){
+            word_type mask = 0;
+            for (std::size_t k = 0; k < per_word; ++k) mask |= low_mask(BitWidth) << (k * BitStride);
+
+            unsigned char* word_ptr = bytes + (bit_offset >> 3);
+            for (; i + per_word <= block_count; i += per_word, word_ptr += 8){
+                const word_type word = pack_word<BitWidth, BitStride>(src + i, std::make_index_sequence<per_word> { });
+                store_word(word_ptr, BitWidth == BitStride ? word : (load_word(word_ptr) & ~mask) | word);
+            }
+        }
+    }
+    i += pack_fields<BitWidth, BitStride>(src + i, count - i, bytes, bit_offset + static_cast<std::ptrdiff_t>(i) * BitStride, BitWidth, BitStride);
+    for (; i < count; ++i){
+        insert(bytes, bit_offset + static_cast<std::ptrdiff_t>(i) * BitStride, BitWidth, static_cast<word_type>(src[i]));
+    }
+}
+
+/**
+ * @brief Packs \p count values from \p src into bit fields whose width and stride are known at runtime. Bits outside the fields are preserved.
+ *
+ * @note \p bit_width must be in [1, 64] and at most the width of \p Tp; it is not checked. It is recomended to use
+ * bit_pack<Tp, BitWidth, BitStride> if the layout is known at the compile time.
+ */
+template <typename Tp>
+void bit_pack(const Tp* src, std::size_t count, void* dst, std::ptrdiff_t bit_width, std::ptrdiff_t bit_stride, std::ptrdiff_t bit_offset = 0) noexcept {
+    using namespace bit_strided_detail;
+
+    auto* bytes = static_cast<unsigned char*>(dst);
+    std::size_t i = 0;
+
+    if (bit_width > 0 && bit_width <= bit_stride){
+        i = pack_fields(src, count, bytes, bit_offset, bit_width, bit_stride);
+    }
+    for (; i < count; ++i){
+        insert(bytes, bit_offset + static_cast<std::ptrdiff_t>(i) * bit_stride, bit_width, static_cast<word_type>(src[i]));
+    }
+}
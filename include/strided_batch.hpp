@@ -0,0 +1,226 @@
+/**
+ * @file strided_batch.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <strided_iterator.hpp>
+#include <const_strided_iterator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if !defined(STRIDED_ITERATOR_NO_SIMD) && __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define STRIDED_ITERATOR_HAS_SIMD 1
+#else
+#define STRIDED_ITERATOR_HAS_SIMD 0
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace strided_batch_detail{
+    template <typename Tp>
+    constexpr bool is_vectorizable = std::is_arithmetic_v<Tp> && !std::is_same_v<Tp, bool>;
+
+    template <typename Tp, std::size_t N, bool = STRIDED_ITERATOR_HAS_SIMD && is_vectorizable<Tp>>
+    struct batch_type { using type = std::array<Tp, N>; };
+
+#if STRIDED_ITERATOR_HAS_SIMD
+    template <typename Tp, std::size_t N>
+    struct batch_type<Tp, N, true> { using type = std::experimental::fixed_size_simd<Tp, N>; };
+#endif
+}
+
+/**
+ * @brief N values loaded from a strided sequence: std::experimental::fixed_size_simd<Tp, N> if it is available and \p Tp is arithmetic,
+ * otherwise std::array<Tp, N>. Both support reading/writing lane k with operator[].
+ *
+ * @note Define STRIDED_ITERATOR_NO_SIMD to always use std::array.
+ */
+template <typename Tp, std::size_t N>
+using strided_batch = typename strided_batch_detail::batch_type<Tp, N>::type;
+
+namespace strided_batch_detail{
+    template <typename Tp, std::size_t N>
+    constexpr bool is_simd = !std::is_same_v<strided_batch<Tp, N>, std::array<Tp, N>>;
+
+    // Builds a batch whose lane k is gen(std::integral_constant<std::size_t, k>), so the lane index is a constant expression.
+    template <typename Tp, std::size_t N, typename Generator>
+    strided_batch<Tp, N> generate(Generator gen) noexcept {
+        if constexpr (is_simd<Tp, N>){
+            return strided_batch<Tp, N>(gen);
+        }
+        else{
+            return [&]<std::size_t... I>(std::index_sequence<I...>){
+                return strided_batch<Tp, N> { gen(std::integral_constant<std::size_t, I> { })... };
+            }(std::make_index_sequence<N> { });
+        }
+    }
+
+#if defined(__AVX2__)
+    // Gathers lanes with one AVX2 instruction if a batch fills a 256-bit register. The masked forms are used only because
+    // they take an explicit source operand (GCC warns about the undefined one of the unmasked forms).
+    template <typename Tp, std::size_t N>
+    constexpr bool has_avx2_gather = is_vectorizable<Tp> && N * sizeof(Tp) == 32 && (sizeof(Tp) == 4 || sizeof(Tp) == 8);
+
+    template <typename Tp>
+    void avx2_gather(const Tp* ptr, std::ptrdiff_t stride, Tp* lanes) noexcept {
+        const auto index_stride = _mm256_set1_epi32(static_cast<int>(stride));
+        if constexpr (sizeof(Tp) == 4){
+            const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), index_stride);
+            if constexpr (std::is_floating_point_v<Tp>){
+                _mm256_storeu_ps(reinterpret_cast<float*>(lanes), _mm256_mask_i32gather_ps(_mm256_setzero_ps(), reinterpret_cast<const float*>(ptr), index, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4));
+            }
+            else{
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int*>(ptr), index, _mm256_set1_epi32(-1), 4));
+            }
+        }
+        else{
+            const __m128i index = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm256_castsi256_si128(index_stride));
+            if constexpr (std::is_floating_point_v<Tp>){
+                _mm256_storeu_pd(reinterpret_cast<double*>(lanes), _mm256_mask_i32gather_pd(_mm256_setzero_pd(), reinterpret_cast<const double*>(ptr), index, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8));
+            }
+            else{
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), reinterpret_cast<const long long*>(ptr), index, _mm256_set1_epi64x(-1), 8));
+            }
+        }
+    }
+#endif
+
+    template <std::size_t N, std::ptrdiff_t Stride, typename Tp>
+    strided_batch<Tp, N> load(const Tp* ptr) noexcept {
+#if STRIDED_ITERATOR_HAS_SIMD
+        if constexpr (Stride == 1 && is_simd<Tp, N>){
+            strided_batch<Tp, N> batch;
+            batch.copy_from(ptr, std::experimental::element_aligned);
+            return batch;
+        }
+#endif
+        // Constant offsets let the compiler pick the shuffle sequence for this stride.
+        return generate<Tp, N>([ptr](auto i){ return ptr[static_cast<std::ptrdiff_t>(decltype(i)::value) * Stride]; });
+    }
+
+    template <std::size_t N, typename Tp>
+    strided_batch<Tp, N> load(const Tp* ptr, std::ptrdiff_t stride) noexcept {
+#if defined(__AVX2__)
+        if constexpr (has_avx2_gather<Tp, N>){
+            constexpr std::ptrdiff_t max_stride = std::numeric_limits<int>::max() / static_cast<std::ptrdiff_t>(N);
+            if (-max_stride <= stride && stride <= max_stride){
+                std::array<Tp, N> lanes;
+                avx2_gather(ptr, stride, lanes.data());
+                return generate<Tp, N>([&lanes](auto i){ return lanes[decltype(i)::value]; });
+            }
+        }
+#endif
+        return generate<Tp, N>([ptr, stride](auto i){ return ptr[static_cast<std::ptrdiff_t>(decltype(i)::value) * stride]; });
+    }
+
+    template <std::size_t N, typename Tp>
+    strided_batch<Tp, N> load_masked(const Tp* ptr, std::ptrdiff_t stride, std::size_t count) noexcept {
+        strided_batch<Tp, N> batch { };
+        for (std::size_t k = 0; k < N && k < count; ++k){
+            batch[k] = ptr[static_cast<std::ptrdiff_t>(k) * stride];
+        }
+        return batch;
+    }
+
+    template <std::size_t N, std::ptrdiff_t Stride, typename Tp>
+    void store(Tp* ptr, const strided_batch<Tp, N>& batch) noexcept {
+#if STRIDED_ITERATOR_HAS_SIMD
+        if constexpr (Stride == 1 && is_simd<Tp, N>){
+            batch.copy_to(ptr, std::experimental::element_aligned);
+            return;
+        }
+#endif
+        [&]<std::size_t... I>(std::index_sequence<I...>){
+            ((ptr[static_cast<std::ptrdiff_t>(I) * Stride] = batch[I]), ...);
+        }(std::make_index_sequence<N> { });
+    }
+
+    template <std::size_t N, typename Tp>
+    void store(Tp* ptr, std::ptrdiff_t stride, const strided_batch<Tp, N>& batch) noexcept {
+        [&]<std::size_t... I>(std::index_sequence<I...>){
+            ((ptr[static_cast<std::ptrdiff_t>(I) * stride] = batch[I]), ...);
+        }(std::make_index_sequence<N> { });
+    }
+
+    template <std::size_t N, typename Tp>
+    void store_masked(Tp* ptr, std::ptrdiff_t stride, const strided_batch<Tp, N>& batch, std::size_t count) noexcept {
+        for (std::size_t k = 0; k < N && k < count; ++k){
+            ptr[static_cast<std::ptrdiff_t>(k) * stride] = batch[k];
+        }
+    }
+}
+
+/**
+ * @brief Loads the N elements it[0], ..., it[N - 1] at once.
+ *
+ * @tparam N Number of elements
+ * @return strided_batch<Tp, N> whose lane k is it[k]
+ *
+ * @note If the stride is known at the compile time, the loads use constant offsets (a plain vector load for Stride 1), otherwise gather instructions
+ * are used when AVX2 is enabled and the batch fills a 256-bit register.
+ */
+template <std::size_t N, typename Tp, std::ptrdiff_t... Stride>
+strided_batch<Tp, N> load_batch(const strided_iterator<Tp, Stride...>& it) noexcept {
+    if constexpr (sizeof...(Stride) == 1){
+        return strided_batch_detail::load<N, Stride...>(static_cast<const Tp*>(it.operator->()));
+    }
+    else{
+        return strided_batch_detail::load<N>(static_cast<const Tp*>(it.operator->()), it.stride());
+    }
+}
+
+template <std::size_t N, typename Tp, std::ptrdiff_t... Stride>
+strided_batch<Tp, N> load_batch(const const_strided_iterator<Tp, Stride...>& it) noexcept {
+    if constexpr (sizeof...(Stride) == 1){
+        return strided_batch_detail::load<N, Stride...>(it.operator->());
+    }
+    else{
+        return strided_batch_detail::load<N>(it.operator->(), it.stride());
+    }
+}
+
+/**
+ * @brief Loads the first \p count elements of it[0], ..., it[N - 1]. Other lanes are value-initialized and their elements are never accessed,
+ * so it can be used for the tail of a sequence.
+ */
+template <std::size_t N, typename Tp, std::ptrdiff_t... Stride>
+strided_batch<Tp, N> load_batch(const strided_iterator<Tp, Stride...>& it, std::size_t count) noexcept { return strided_batch_detail::load_masked<N>(static_cast<const Tp*>(it.operator->()), it.stride(), count); }
+
+template <std::size_t N, typename Tp, std::ptrdiff_t... Stride>
+strided_batch<Tp, N> load_batch(const const_strided_iterator<Tp, Stride...>& it, std::size_t count) noexcept { return strided_batch_detail::load_masked<N>(it.operator->(), it.stride(), count); }
+
+/**
+ * @brief Stores the lanes of \p batch to it[0], ..., it[N - 1].
+ */
+template <std::size_t N, typename Tp, std::ptrdiff_t... Stride>
+void store_batch(const strided_iterator<Tp, Stride...>& it, const strided_batch<Tp, N>& batch) noexcept {
+    if constexpr (sizeof...(Stride) == 1){
+        strided_batch_detail::store<N, Stride...>(it.operator->(), batch);
+    }
+    else{
+        strided_batch_detail::store<N>(it.operator->(), it.stride(), batch);
+    }
+}
+
+/**
+ * @brief Stores the first \p count lanes of \p batch to it[0], ..., it[count - 1]. Other elements are never accessed.
+ */
+template <std::size_t N, typename Tp, std::ptrdiff_t... Stride>
+void store_batch(const strided_iterator<Tp, Stride...>& it, const strided_batch<Tp, N>& batch, std::size_t count) noexcept {
+    strided_batch_detail::store_masked<N>(it.operator->(), it.stride(), batch, count);
+}
@@ -0,0 +1,242 @@
+/**
+ * @file strided_compact.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace strided_compact_detail{
+    // Records are selected 64 at a time, one bit each in a mask word.
+    using mask_type = std::uint64_t;
+    constexpr std::size_t block_size = 64;
+
+    // A block is moved run by run (instead of record by record) after a block whose runs of selected or rejected records averaged at least
+    // this many records.
+    constexpr std::size_t long_run = 8;
+
+    inline mask_type low_mask(std::size_t count) noexcept { return count >= block_size ? ~mask_type { } : (mask_type { 1 } << count) - 1; }
+
+    inline bool has_long_runs(mask_type mask, std::size_t count) noexcept {
+        const auto changes = static_cast<std::size_t>(std::popcount((mask ^ (mask >> 1)) & low_mask(count - 1)));
+        return count >= long_run * (changes + 1);
+    }
+
+    template <typename Key>
+    Key load_key(const unsigned char* key) noexcept {
+        Key value;
+        std::memcpy(&value, key, sizeof(Key));
+        return value;
+    }
+
+    // Moves a record. If \p RecordSize is not 0, it is record_size, so the move is a few fixed-size loads and stores.
+    template <std::size_t RecordSize>
+    void move_record(unsigned char* dst, const unsigned char* src, std::size_t record_size) noexcept {
+        if constexpr (RecordSize != 0) std::memmove(dst, src, RecordSize);
+        else std::memmove(dst, src, record_size);
+    }
+
+    // Evaluates \p pred on the keys of \p count (at most block_size) records, combining the results without branches.
+    template <typename Key, std::size_t RecordSize, typename Predicate>
+    mask_type select(const unsigned char* key, std::size_t count, std::size_t record_size, Predicate& pred){
+        if constexpr (RecordSize != 0) record_size = RecordSize;
+        mask_type mask = 0;
+        for (std::size_t i = 0; i < count; ++i){
+            mask |= static_cast<mask_type>(static_cast<bool>(pred(load_key<Key>(key + i * record_size)))) << i;
+        }
+        return mask;
+    }
+
+    // Copies the runs of records of \p src selected by \p mask to \p dst in order, one memmove each, and returns the end of the copied records.
+    // \p dst may overlap \p src if it is not after it.
+    inline unsigned char* move_runs(const unsigned char* src, mask_type mask, std::size_t record_size, unsigned char* dst) noexcept {
+        while (mask != 0){
+            const int first = std::countr_zero(mask);
+            const int run = std::countr_one(mask >> first);
+            const std::size_t bytes = static_cast<std::size_t>(run) * record_size;
+            std::memmove(dst, src + first * record_size, bytes);
+            dst += bytes;
+            mask = first + run >= 64 ? 0 : mask & (~mask_type { } << (first + run));
+        }
+        return dst;
+    }
+
+    // Copies every one of \p count records of \p src to \p dst, advancing \p dst only past the selected ones, so nothing branches on the
+    // data: a rejected record is overwritten by the next one. The slot after the last selected record may be written, but never one past
+    // the count-th. Returns the selection mask.
+    template <typename Key, std::size_t RecordSize, typename Predicate>
+    mask_type compress_records(const unsigned char* src, std::size_t count, std::size_t record_size, std::size_t key_offset, unsigned char*& dst, Predicate& pred){
+        if constexpr (RecordSize != 0) record_size = RecordSize;
+        mask_type mask = 0;
+        unsigned char* out = dst;
+        for (std::size_t i = 0; i < count; ++i){
+            const unsigned char* record = src + i * record_size;
+            const bool selected = pred(load_key<Key>(record + key_offset));
+            move_record<RecordSize>(out, record, record_size);
+            out += record_size * selected;
+            mask |= static_cast<mask_type>(selected) << i;
+        }
+        dst = out;
+        return mask;
+    }
+
+    // Same as compress_records, but also copies every record to \p rejected, advancing it only past the rejected ones.
+    template <typename Key, std::size_t RecordSize, typename Predicate>
+    mask_type partition_records(const unsigned char* src, std::size_t count, std::size_t record_size, std::size_t key_offset, unsigned char*& dst,
+                                unsigned char*& rejected, Predicate& pred){
+        if constexpr (RecordSize != 0) record_size = RecordSize;
+        mask_type mask = 0;
+        unsigned char* out = dst, * rejected_out = rejected;
+        for (std::size_t i = 0; i < count; ++i){
+            const unsigned char* record = src + i * record_size;
+            const bool selected = pred(load_key<Key>(record + key_offset));
+            // Saved before the record is moved, because out may be record itself.
+            move_record<RecordSize>(rejected_out, record, record_size);
+            rejected_out += record_size * !selected;
+            move_record<RecordSize>(out, record, record_size);
+            out += record_size * selected;
+            mask |= static_cast<mask_type>(selected) << i;
+        }
+        dst = out;
+        rejected = rejected_out;
+        return mask;
+    }
+
+    // Calls \p function with std::integral_constant<std::size_t, record_size> for the common record sizes, otherwise with 0.
+    template <typename Function>
+    decltype(auto) with_record_size(std::size_t record_size, Function function){
+        switch (record_size){
+            case 1: return function(std::integral_constant<std::size_t, 1> { });
+            case 2: return function(std::integral_constant<std::size_t, 2> { });
+            case 4: return function(std::integral_constant<std::size_t, 4> { });
+            case 8: return function(std::integral_constant<std::size_t, 8> { });
+            case 12: return function(std::integral_constant<std::size_t, 12> { });
+            case 16: return function(std::integral_constant<std::size_t, 16> { });
+            case 24: return function(std::integral_constant<std::size_t, 24> { });
+            case 32: return function(std::integral_constant<std::size_t, 32> { });
+            case 64: return function(std::integral_constant<std::size_t, 64> { });
+            default: return function(std::integral_constant<std::size_t, 0> { });
+        }
+    }
+
+    // Compacts \p count records of \p in to \p out, which is \p in or doesn't overlap it.
+    template <std::size_t RecordSize, typename Key, typename Predicate>
+    unsigned char* compact(const unsigned char* in, std::size_t count, std::size_t record_size, std::size_t key_offset, unsigned char* out, Predicate& pred){
+        bool runs = false;
+        for (std::size_t i = 0; i < count; i += block_size, in += block_size * record_size){
+            const std::size_t n = std::min(block_size, count - i);
+            mask_type mask;
+            if (runs){
+                mask = select<Key, RecordSize>(in + key_offset, n, record_size, pred);
+                out = move_runs(in, mask, record_size, out);
+            }
+            else{
+                mask = compress_records<Key, RecordSize>(in, n, record_size, key_offset, out, pred);
+            }
+            runs = has_long_runs(mask, n);
+        }
+        return out;
+    }
+}
+
+/**
+ * @brief Copies the records whose key satisfies \p pred to \p dst, keeping their order.
+ *
+ * @tparam Key Type of the key field
+ * @param src Array of \p count records of \p record_size bytes
+ * @param key_offset Byte offset of the key in a record (the key needs no alignment)
+ * @param dst Destination of the selected records. It must not overlap \p src, and must have room for \p count records (or one more
+ * than the number of selected records), because a rejected record may be written after the selected ones before being overwritten.
+ * @return Number of records copied
+ *
+ * @note The keys are the strided sequence of stride \p record_size bytes from src + key_offset. Every record is copied and the destination
+ * advances only past the selected ones, so there is no branch on the data per record. Common record sizes (1, 2, 4, 8, 12, 16, 24, 32 and
+ * 64 bytes) are copied with fixed-size moves. Where the selection comes in long runs (judged from the 64-record mask of the previous block),
+ * the selected runs are moved with one memmove each instead, and long rejected runs aren't copied at all.
+ */
+template <typename Key, typename Predicate>
+std::size_t strided_compact_copy(const void* src, std::size_t count, std::size_t record_size, std::size_t key_offset, void* dst, Predicate pred){
+    using namespace strided_compact_detail;
+    static_assert(std::is_trivially_copyable_v<Key>, "strided_compact_copy requires trivially copyable Key.");
+
+    auto* out = static_cast<unsigned char*>(dst);
+    const unsigned char* last = with_record_size(record_size, [&](auto size){
+        return compact<decltype(size)::value, Key>(static_cast<const unsigned char*>(src), count, record_size, key_offset, out, pred);
+    });
+    return static_cast<std::size_t>(last - out) / record_size;
+}
+
+/**
+ * @brief Removes the records whose key doesn't satisfy \p pred, moving the others to the front in order (like std::remove_if, inverted).
+ *
+ * @tparam Key Type of the key field
+ * @param records Array of \p count records of \p record_size bytes
+ * @param key_offset Byte offset of the key in a record
+ * @return Number of records kept. The records after them are left unspecified.
+ */
+template <typename Key, typename Predicate>
+std::size_t strided_compact(void* records, std::size_t count, std::size_t record_size, std::size_t key_offset, Predicate pred){
+    using namespace strided_compact_detail;
+    static_assert(std::is_trivially_copyable_v<Key>, "strided_compact requires trivially copyable Key.");
+
+    auto* out = static_cast<unsigned char*>(records);
+    const unsigned char* last = with_record_size(record_size, [&](auto size){
+        return compact<decltype(size)::value, Key>(out, count, record_size, key_offset, out, pred);
+    });
+    return static_cast<std::size_t>(last - out) / record_size;
+}
+
+/**
+ * @brief Reorders the records so that those whose key satisfies \p pred come first, keeping the relative order in both groups
+ * (like std::stable_partition).
+ *
+ * @return Number of records satisfying \p pred
+ *
+ * @note The rejected records are compressed into a temporary buffer the same way, then appended after the selected ones.
+ */
+template <typename Key, typename Predicate>
+std::size_t strided_stable_partition(void* records, std::size_t count, std::size_t record_size, std::size_t key_offset, Predicate pred){
+    using namespace strided_compact_detail;
+    static_assert(std::is_trivially_copyable_v<Key>, "strided_stable_partition requires trivially copyable Key.");
+
+    std::vector<unsigned char> rejected(count * record_size);
+    auto* first = static_cast<unsigned char*>(records);
+    unsigned char* last = with_record_size(record_size, [&](auto size){
+        constexpr std::size_t RecordSize = decltype(size)::value;
+        unsigned char* in = first, * out = first, * rejected_out = rejected.data();
+        bool runs = false;
+        for (std::size_t i = 0; i < count; i += block_size, in += block_size * record_size){
+            const std::size_t n = std::min(block_size, count - i);
+            mask_type mask;
+            if (runs){
+                mask = select<Key, RecordSize>(in + key_offset, n, record_size, pred);
+                // The rejected records must be saved before the selected ones of this block overwrite them.
+                rejected_out = move_runs(in, ~mask & low_mask(n), record_size, rejected_out);
+                out = move_runs(in, mask, record_size, out);
+            }
+            else{
+                mask = partition_records<Key, RecordSize>(in, n, record_size, key_offset, out, rejected_out, pred);
+            }
+            runs = has_long_runs(mask, n);
+        }
+
+        const std::size_t rejected_bytes = static_cast<std::size_t>(rejected_out - rejected.data());
+        if (rejected_bytes != 0){
+            std::memcpy(out, rejected.data(), rejected_bytes);
+        }
+        return out;
+    });
+    return static_cast<std::size_t>(last - first) / record_size;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file strided_histogram.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <strided_iterator.hpp>
+#include <const_strided_iterator.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace strided_histogram_detail{
+    // Banks hold 32-bit counters to halve their cache footprint, and are merged before they could overflow.
+    using counter_type = std::uint32_t;
+    constexpr std::size_t max_bank_count = std::numeric_limits<counter_type>::max();
+
+    template <typename Tp>
+    constexpr std::size_t bin_count = std::size_t { 1 } << (sizeof(Tp) * CHAR_BIT);
+
+    // Consecutive equal values increment different banks, so they don't wait for each other through store-to-load forwarding.
+    // 16-bit tables are 64 times larger, so fewer banks keep them in the cache.
+    template <typename Tp>
+    constexpr std::size_t bank_count = sizeof(Tp) == 1 ? 4 : 2;
+
+    template <typename Tp>
+    constexpr std::size_t bin(Tp value) noexcept { return static_cast<std::make_unsigned_t<Tp>>(value); }
+
+    template <typename Iterator>
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+
+    template <typename Tp>
+    constexpr void check_value_type() noexcept {
+        static_assert(std::is_integral_v<Tp> && (sizeof(Tp) == 1 || sizeof(Tp) == 2), "strided_histogram requires 8/16-bit integral elements.");
+    }
+
+    // Adds the histogram of first[0], ..., first[count - 1] to \p histogram.
+    template <typename Iterator>
+    void accumulate(Iterator first, std::size_t count, std::size_t* histogram){
+        using Tp = value_type<Iterator>;
+        constexpr std::size_t bins = bin_count<Tp>, banks = bank_count<Tp>;
+
+        std::vector<counter_type> table(bins * banks);
+        while (count > 0){
+            const std::size_t chunk = std::min(count, max_bank_count);
+
+            std::size_t i = 0;
+            for (; i + banks <= chunk; i += banks){
+                for (std::size_t b = 0; b < banks; ++b){
+                    ++table[b * bins + bin<Tp>(first[static_cast<std::ptrdiff_t>(i + b)])];
+                }
+            }
+            for (; i < chunk; ++i){
+                ++table[bin<Tp>(first[static_cast<std::ptrdiff_t>(i)])];
+            }
+
+            for (std::size_t b = 0; b < banks; ++b){
+                for (std::size_t k = 0; k < bins; ++k){
+                    histogram[k] += table[b * bins + k];
+                }
+            }
+            std::fill(table.begin(), table.end(), 0);
+
+            first += static_cast<std::ptrdiff_t>(chunk);
+            count -= chunk;
+        }
+    }
+}
+
+/**
+ * @brief Counts the occurrences of each value in [first, last).
+ *
+ * @tparam Iterator Random access iterator (e.g. strided_iterator<Tp, Stride>) whose value type is an 8/16-bit integer
+ * @return Histogram with 2^(bits of the value type) bins. Signed values are binned by their bit pattern, e.g. int8_t(-1) goes to the bin 255.
+ *
+ * @note last - first must be the multiple of the stride, as for the STL algorithms.
+ */
+template <typename Iterator>
+std::vector<std::size_t> strided_histogram(Iterator first, Iterator last){
+    using Tp = strided_histogram_detail::value_type<Iterator>;
+    strided_histogram_detail::check_value_type<Tp>();
+
+    std::vector<std::size_t> histogram(strided_histogram_detail::bin_count<Tp>);
+    strided_histogram_detail::accumulate(first, static_cast<std::size_t>(last - first), histogram.data());
+    return histogram;
+}
+
+/**
+ * @brief Counts the elements in [first, last) satisfying \p pred, like std::count_if.
+ *
+ * @note The predicate results are added without branches into 4 independent counters, so a mispredicted or long dependency chain
+ * doesn't serialize the loop. last - first must be the multiple of the stride.
+ */
+template <typename Iterator, typename Predicate>
+std::size_t strided_count_if(Iterator first, Iterator last, Predicate pred){
+    constexpr std::size_t lanes = 4;
+    const auto count = static_cast<std::size_t>(last - first);
+
+    std::size_t counts[lanes] { };
+    std::size_t i = 0;
+    for (; i + lanes <= count; i += lanes){
+        for (std::size_t l = 0; l < lanes; ++l){
+            counts[l] += static_cast<bool>(pred(first[static_cast<std::ptrdiff_t>(i + l)]));
+        }
+    }
+    for (; i < count; ++i){
+        counts[0] += static_cast<bool>(pred(first[static_cast<std::ptrdiff_t>(i)]));
+    }
+    return counts[0] + counts[1] + counts[2] + counts[3];
+}
+
+/**
+ * @brief Counts the occurrences of each value of every channel of an interleaved buffer in one pass.
+ *
+ * @param data Interleaved buffer of \p records records, each \p channels elements long
+ * @param records Number of records
+ * @param channels Number of channels
+ * @return Histogram of each channel, i.e. histograms[c] is strided_histogram of const_strided_iterator<Tp> { data + c, channels }.
+ */
+template <typename Tp>
+std::vector<std::vector<std::size_t>> strided_histogram(const Tp* data, std::size_t records, std::size_t channels){
+    using namespace strided_histogram_detail;
+    check_value_type<Tp>();
+    constexpr std::size_t bins = bin_count<Tp>, banks = bank_count<Tp>;
+
+    std::vector<std::vector<std::size_t>> histograms(channels, std::vector<std::size_t>(bins));
+    std::vector<counter_type> table(channels * banks * bins);
+    while (records > 0){
+        const std::size_t chunk = std::min(records, max_bank_count);
+
+        // Record r goes to the bank r % banks, so a channel's consecutive samples land on different banks.
+        std::size_t r = 0;
+        for (; r + banks <= chunk; r += banks){
+            for (std::size_t b = 0; b < banks; ++b){
+                const Tp* record = data + (r + b) * channels;
+                for (std::size_t c = 0; c < channels; ++c){
+                    ++table[(c * banks + b) * bins + bin<Tp>(record[c])];
+                }
+            }
+        }
+        for (; r < chunk; ++r){
+            const Tp* record = data + r * channels;
+            for (std::size_t c = 0; c < channels; ++c){
+                ++table[c * banks * bins + bin<Tp>(record[c])];
+            }
+        }
+
+        for (std::size_t c = 0; c < channels; ++c){
+            for (std::size_t b = 0; b < banks; ++b){
+                const counter_type* bank = table.data() + (c * banks + b) * bins;
+                for (std::size_t k = 0; k < bins; ++k){
+                    histograms[c][k] += bank[k];
+                }
+            }
+        }
+        std::fill(table.begin(), table.end(), 0);
+
+        data += chunk * channels;
+        records -= chunk;
+    }
+    return histograms;
+}
+
+/**
+ * @brief Multithreaded strided_histogram: [first, last) is split into \p thread_count contiguous subranges, each counted into private
+ * banks by its own thread, then the results are merged.
+ *
+ * @param thread_count Number of threads. If it is 0, std::thread::hardware_concurrency() is used.
+ *
+ * @note If a thread can't be started, the exception is rethrown after the started threads finished.
+ */
+template <typename Iterator>
+std::vector<std::size_t> strided_histogram_parallel(Iterator first, Iterator last, unsigned thread_count = 0){
+    using Tp = strided_histogram_detail::value_type<Iterator>;
+    strided_histogram_detail::check_value_type<Tp>();
+    constexpr std::size_t bins = strided_histogram_detail::bin_count<Tp>;
+
+    const auto count = static_cast<std::size_t>(last - first);
+    if (thread_count == 0){
+        thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    thread_count = static_cast<unsigned>(std::min<std::size_t>(thread_count, std::max<std::size_t>(count / bins, 1)));
+
+    std::vector<std::size_t> histograms(thread_count * bins);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    try{
+        for (unsigned t = 1; t < thread_count; ++t){
+            const std::size_t begin = count * t / thread_count, end = count * (t + 1) / thread_count;
+            threads.emplace_back([=, &histograms]{
+                strided_histogram_detail::accumulate(first + static_cast<std::ptrdiff_t>(begin), end - begin, histograms.data() + t * bins);
+            });
+        }
+    }
+    catch (...){
+        // Destroying a joinable thread would terminate, so wait for the started ones before reporting the failure.
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+        throw;
+    }
+    strided_histogram_detail::accumulate(first, count / thread_count, histograms.data());
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+
+    for (unsigned t = 1; t < thread_count; ++t){
+        for (std::size_t k = 0; k < bins; ++k){
+            histograms[k] += histograms[t * bins + k];
+        }
+    }
+    histograms.resize(bins);
+    return histograms;
+}
@@ -10,8 +10,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
+
+#if __cplusplus > 201703L
+#include <memory>
+#include <ranges>
+#endif
 
 template <typename Tp, std::ptrdiff_t...> struct strided_iterator;
 
@@ -47,18 +54,30 @@ private:
 
 public:
     // Constructors
-    strided_iterator() noexcept : _ptr { } { }
-    strided_iterator(pointer ptr) noexcept : _ptr { ptr } { }
+    constexpr strided_iterator() noexcept : _ptr { } { }
+    constexpr strided_iterator(pointer ptr) noexcept : _ptr { ptr } { }
+#if __cplusplus > 201703L
+    // From any contiguous iterator of Tp (std::vector<Tp>::iterator, std::span<Tp>::iterator, ...), without dereferencing it.
+    // self_type is excluded first, because checking std::contiguous_iterator<self_type> needs this constructor.
+    template <typename Iterator>
+        requires (!std::is_same_v<Iterator, self_type>) && std::contiguous_iterator<Iterator> && std::is_same_v<std::iter_value_t<Iterator>, Tp>
+                 && std::is_convertible_v<decltype(std::to_address(std::declval<const Iterator&>())), pointer>
+    constexpr strided_iterator(const Iterator& iterator) noexcept : _ptr { std::to_address(iterator) } { }
+#elif defined(_LIBCPP_VERSION)
     strided_iterator(std::__wrap_iter<pointer> wrap_iter) noexcept : _ptr { wrap_iter.base() } { }
-    strided_iterator(const self_type& source) noexcept : _ptr { source._ptr } { }
+#endif
+    constexpr strided_iterator(const self_type& source) noexcept : _ptr { source._ptr } { }
 
     self_type& operator=(const self_type& iterator) noexcept { _ptr = iterator._ptr; return *this; }
     self_type& operator=(pointer ptr) noexcept { _ptr = ptr; return *this; }
 
+    // Accessors
+    static constexpr difference_type stride() noexcept { return Stride; }
+
     // Tp* like operators
-    reference operator*() const noexcept { return *_ptr; }
-    pointer operator->() const noexcept { return _ptr; }
-    reference operator[](difference_type n) const noexcept { return _ptr[n * Stride]; }
+    constexpr reference operator*() const noexcept { return *_ptr; }
+    constexpr pointer operator->() const noexcept { return _ptr; }
+    constexpr reference operator[](difference_type n) const noexcept { return _ptr[n * Stride]; }
 
     // Increment / Decrement
     self_type& operator++() noexcept { _ptr += Stride; return *this; }
@@ -74,7 +93,7 @@ public:
     friend self_type operator-(self_type left, difference_type n) noexcept { left -= n; return left; }
     
     // Difference
-    friend difference_type operator-(const self_type& left, const self_type& right) noexcept { return (right._ptr - left._ptr) / Stride; }
+    friend difference_type operator-(const self_type& left, const self_type& right) noexcept { return (left._ptr - right._ptr) / Stride; }
 
     // Comparison operators
     friend bool operator==(const self_type& left, const self_type& right) noexcept { return left._ptr == right._ptr; }
@@ -111,18 +130,29 @@ private:
 
 public:
     // Constructors
-    strided_iterator(difference_type stride = 1) noexcept : _ptr { }, _stride { stride } { }
-    strided_iterator(Tp* ptr, difference_type stride = 1) noexcept : _ptr { ptr }, _stride { stride } { }
+    constexpr strided_iterator(difference_type stride = 1) noexcept : _ptr { }, _stride { stride } { }
+    constexpr strided_iterator(Tp* ptr, difference_type stride = 1) noexcept : _ptr { ptr }, _stride { stride } { }
+#if __cplusplus > 201703L
+    // From any contiguous iterator of Tp (std::vector<Tp>::iterator, std::span<Tp>::iterator, ...), without dereferencing it.
+    template <typename Iterator>
+        requires (!std::is_same_v<Iterator, self_type>) && std::contiguous_iterator<Iterator> && std::is_same_v<std::iter_value_t<Iterator>, Tp>
+                 && std::is_convertible_v<decltype(std::to_address(std::declval<const Iterator&>())), pointer>
+    constexpr strided_iterator(const Iterator& iterator, difference_type stride = 1) noexcept : _ptr { std::to_address(iterator) }, _stride { stride } { }
+#elif defined(_LIBCPP_VERSION)
     strided_iterator(std::__wrap_iter<Tp*> wrap_iter, difference_type stride = 1) noexcept : _ptr { wrap_iter.base() }, _stride { stride } { }
-    strided_iterator(const self_type& source) noexcept : _ptr { source._ptr }, _stride { source._stride } { }
+#endif
+    constexpr strided_iterator(const self_type& source) noexcept : _ptr { source._ptr }, _stride { source._stride } { }
 
     self_type& operator=(const self_type& iterator) noexcept { _ptr = iterator._ptr; return *this; }
     self_type& operator=(pointer ptr) noexcept { _ptr = ptr; return *this; }
 
+    // Accessors
+    constexpr difference_type stride() const noexcept { return _stride; }
+
     // Tp* like operators
-    reference operator*() const noexcept { return *_ptr; }
-    pointer operator->() const noexcept { return _ptr; }
-    reference operator[](difference_type n) const noexcept { return _ptr[n * _stride]; }
+    constexpr reference operator*() const noexcept { return *_ptr; }
+    constexpr pointer operator->() const noexcept { return _ptr; }
+    constexpr reference operator[](difference_type n) const noexcept { return _ptr[n * _stride]; }
 
     // Increment / Decrement
     self_type& operator++() noexcept { _ptr += _stride; return *this; }
@@ -144,7 +174,7 @@ public:
             throw std::runtime_error { "strided_iterator<Tp> subtract operation with different strides." };
         }
 #endif
-        return (right._ptr - left._ptr) / left._stride;
+        return (left._ptr - right._ptr) / left._stride;
     }
 
     // Comparison operators
@@ -154,4 +184,30 @@ public:
     friend bool operator<=(const self_type& left, const self_type& right) noexcept { return left._ptr <= right._ptr; }
     friend bool operator>(const self_type& left, const self_type& right) noexcept { return left._ptr > right._ptr; }
     friend bool operator>=(const self_type& left, const self_type& right) noexcept { return left._ptr >= right._ptr; }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief strided_iterator<Tp, Stride> at \p data[offset], e.g. over channel \p offset of records of \p Stride elements.
+ */
+template <std::ptrdiff_t Stride, typename Tp>
+constexpr strided_iterator<Tp, Stride> make_strided_iterator(Tp* data, std::size_t offset = 0) noexcept { return { data + offset }; }
+
+/**
+ * @brief strided_iterator<Tp> at \p data[offset] with runtime \p stride.
+ */
+template <typename Tp>
+constexpr strided_iterator<Tp> make_strided_iterator(Tp* data, std::size_t offset, std::ptrdiff_t stride) noexcept { return { data + offset, stride }; }
+
+#if __cplusplus > 201703L
+/**
+ * @brief Same as above, from a contiguous range (std::vector, std::array, std::span, ...) of mutable elements, which is not copied.
+ * The range must outlive the iterator, so temporary containers are rejected.
+ */
+template <std::ptrdiff_t Stride, typename Range>
+    requires std::ranges::contiguous_range<Range> && std::ranges::borrowed_range<Range> && (!std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<Range>>>)
+constexpr auto make_strided_iterator(Range&& range, std::size_t offset = 0) noexcept { return make_strided_iterator<Stride>(std::ranges::data(range), offset); }
+
+template <typename Range>
+    requires std::ranges::contiguous_range<Range> && std::ranges::borrowed_range<Range> && (!std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<Range>>>)
+constexpr auto make_strided_iterator(Range&& range, std::size_t offset, std::ptrdiff_t stride) noexcept { return make_strided_iterator(std::ranges::data(range), offset, stride); }
+#endif
\ No newline at end of file
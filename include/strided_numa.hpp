@@ -0,0 +1,295 @@
+/**
+ * @file strided_numa.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <strided_iterator.hpp>
+#include <const_strided_iterator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Define STRIDED_ITERATOR_USE_LIBNUMA (and link with -lnuma) to pin the workers with libnuma instead of sched_setaffinity.
+#if defined(STRIDED_ITERATOR_USE_LIBNUMA)
+#include <numa.h>
+#endif
+
+/**
+ * @brief CPUs of each NUMA node.
+ *
+ * @note On a machine without NUMA information (or not Linux), it is a single node. If the CPUs are unknown, the node has no CPU
+ * and the workers are not pinned.
+ */
+struct numa_topology{
+    std::vector<std::vector<int>> node_cpus;
+
+    std::size_t node_count() const noexcept { return node_cpus.size(); }
+    std::size_t cpu_count() const noexcept {
+        std::size_t count = 0;
+        for (const std::vector<int>& cpus : node_cpus) count += cpus.size();
+        return count;
+    }
+
+    // Parses a cpulist (or a nodelist) like "0-3,8,10-11".
+    static std::vector<int> parse_cpu_list(const std::string& list){
+        std::vector<int> cpus;
+        std::size_t pos = 0;
+        while (pos < list.size()){
+            std::size_t end = list.find(',', pos);
+            if (end == std::string::npos) end = list.size();
+            const std::string item = list.substr(pos, end - pos);
+            pos = end + 1;
+
+            if (item.find_first_of("0123456789") == std::string::npos) continue;
+            const std::size_t dash = item.find('-');
+            const int first = std::stoi(item.substr(0, dash)), last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    static numa_topology detect(){
+        numa_topology topology;
+#if defined(__linux__)
+        // Node ids may have holes (e.g. 0 and 2 only), so they are listed rather than probed in order.
+        std::string nodes;
+        for (const char* path : { "/sys/devices/system/node/online", "/sys/devices/system/node/possible" }){
+            std::ifstream file { path };
+            if (file && std::getline(file, nodes)) break;
+        }
+        for (int node : parse_cpu_list(nodes)){
+            std::ifstream file { "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist" };
+            std::string list;
+            if (file && std::getline(file, list)){
+                topology.node_cpus.push_back(parse_cpu_list(list));
+            }
+        }
+        // Drop memory-only nodes, workers can't run there.
+        topology.node_cpus.erase(std::remove_if(topology.node_cpus.begin(), topology.node_cpus.end(), [](const std::vector<int>& cpus){ return cpus.empty(); }),
+                                 topology.node_cpus.end());
+#endif
+        if (topology.node_cpus.empty()){
+            topology.node_cpus.emplace_back();
+        }
+        return topology;
+    }
+};
+
+/**
+ * @brief Restricts the calling thread to the CPUs of \p node.
+ *
+ * @return true if the thread was pinned, false if it is not supported or failed (the thread keeps running anywhere).
+ */
+inline bool numa_pin_to_node(const numa_topology& topology, std::size_t node) noexcept {
+    if (node >= topology.node_count() || topology.node_cpus[node].empty()) return false;
+#if defined(STRIDED_ITERATOR_USE_LIBNUMA)
+    if (numa_available() >= 0){
+        // Node ids of libnuma are the ones of sysfs, only memory-only nodes were dropped from the topology.
+        const int cpu = topology.node_cpus[node].front();
+        if (numa_run_on_node(numa_node_of_cpu(cpu)) == 0){
+            numa_set_localalloc();
+            return true;
+        }
+    }
+#endif
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : topology.node_cpus[node]){
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Records [first, last) of a numa_strided_buffer, processed by worker \p worker running on node \p node.
+ */
+struct numa_partition{
+    std::size_t worker;
+    std::size_t node;
+    std::size_t first, last;
+};
+
+/**
+ * @brief A buffer of interleaved records, placed on the NUMA nodes of the workers which process it.
+ *
+ * @tparam Tp Type of the elements (trivially copyable)
+ *
+ * @note The buffer is split into one contiguous partition per worker, with boundaries on page boundaries, and worker w runs on node
+ * w * node_count / workers. The pages are first touched (value-initialized) by the worker owning them, so the kernel places them on its node.
+ * Processing the buffer with parallel_for afterwards keeps every access node local and spreads the traffic over all memory controllers.
+ * On a single node machine it works the same, just without the placement benefit.
+ */
+template <typename Tp>
+class numa_strided_buffer{
+    static_assert(std::is_trivially_copyable_v<Tp> && std::is_trivially_destructible_v<Tp>, "numa_strided_buffer requires trivially copyable Tp.");
+
+public:
+    using value_type = Tp;
+    using partition_type = numa_partition;
+
+private:
+    Tp* _data;
+    std::size_t _records, _record_size, _bytes;
+    numa_topology _topology;
+    std::vector<numa_partition> _partitions;
+
+public:
+    /**
+     * @param records Number of records
+     * @param record_size Number of elements in each record (the stride of its channels)
+     * @param workers Number of workers. If it is 0, one per CPU.
+     * @param topology NUMA topology to place the workers on
+     */
+    numa_strided_buffer(std::size_t records, std::size_t record_size, std::size_t workers = 0, numa_topology topology = numa_topology::detect())
+        : _data { }, _records { records }, _record_size { record_size }, _bytes { records * record_size * sizeof(Tp) }, _topology { std::move(topology) } {
+        if (workers == 0){
+            workers = std::max<std::size_t>({ _topology.cpu_count(), std::thread::hardware_concurrency(), 1 });
+        }
+        _data = allocate(_bytes);
+        try{
+            make_partitions(workers);
+            parallel_for([this](const numa_partition& partition){
+                std::uninitialized_value_construct(_data + partition.first * _record_size, _data + partition.last * _record_size);
+            });
+        }
+        catch (...){
+            deallocate(_data, _bytes);
+            throw;
+        }
+    }
+
+    numa_strided_buffer(const numa_strided_buffer&) = delete;
+    numa_strided_buffer& operator=(const numa_strided_buffer&) = delete;
+    numa_strided_buffer(numa_strided_buffer&& source) noexcept
+        : _data { std::exchange(source._data, nullptr) }, _records { source._records }, _record_size { source._record_size }, _bytes { source._bytes },
+          _topology { std::move(source._topology) }, _partitions { std::move(source._partitions) } { }
+    numa_strided_buffer& operator=(numa_strided_buffer&& source) noexcept {
+        std::swap(_data, source._data);
+        std::swap(_records, source._records);
+        std::swap(_record_size, source._record_size);
+        std::swap(_bytes, source._bytes);
+        std::swap(_topology, source._topology);
+        std::swap(_partitions, source._partitions);
+        return *this;
+    }
+    ~numa_strided_buffer() { deallocate(_data, _bytes); }
+
+    // Accessors
+    Tp* data() noexcept { return _data; }
+    const Tp* data() const noexcept { return _data; }
+    std::size_t size() const noexcept { return _records * _record_size; }
+    std::size_t records() const noexcept { return _records; }
+    std::size_t record_size() const noexcept { return _record_size; }
+    const numa_topology& topology() const noexcept { return _topology; }
+    const std::vector<numa_partition>& partitions() const noexcept { return _partitions; }
+
+    // Iterators over channel \p channel of the records of \p partition
+    strided_iterator<Tp> channel_begin(const numa_partition& partition, std::size_t channel) noexcept { return { _data + partition.first * _record_size + channel, stride() }; }
+    strided_iterator<Tp> channel_end(const numa_partition& partition, std::size_t channel) noexcept { return { _data + partition.last * _record_size + channel, stride() }; }
+    const_strided_iterator<Tp> channel_begin(const numa_partition& partition, std::size_t channel) const noexcept { return { _data + partition.first * _record_size + channel, stride() }; }
+    const_strided_iterator<Tp> channel_end(const numa_partition& partition, std::size_t channel) const noexcept { return { _data + partition.last * _record_size + channel, stride() }; }
+
+    /**
+     * @brief Calls \p function(partition) for every partition, each on its own thread pinned to the node of the partition, and waits for them.
+     *
+     * @note If a thread can't be started, the exception is rethrown after the started threads finished.
+     */
+    template <typename Function>
+    void parallel_for(Function function) const {
+        std::vector<std::thread> threads;
+        threads.reserve(_partitions.size());
+        try{
+            for (const numa_partition& partition : _partitions){
+                threads.emplace_back([this, &function, &partition]{
+                    numa_pin_to_node(_topology, partition.node);
+                    function(partition);
+                });
+            }
+        }
+        catch (...){
+            // Destroying a joinable thread would terminate, so wait for the started ones before reporting the failure.
+            for (std::thread& thread : threads){
+                thread.join();
+            }
+            throw;
+        }
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+    }
+
+private:
+    std::ptrdiff_t stride() const noexcept { return static_cast<std::ptrdiff_t>(_record_size); }
+
+    static std::size_t page_size() noexcept {
+#if defined(__linux__)
+        const long size = sysconf(_SC_PAGESIZE);
+        if (size > 0) return static_cast<std::size_t>(size);
+#endif
+        return 4096;
+    }
+
+    // Pages must not be touched here, so the memory is mapped rather than allocated with new (which may reuse touched pages).
+    static Tp* allocate(std::size_t bytes){
+        if (bytes == 0) return nullptr;
+#if defined(__linux__)
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) throw std::bad_alloc { };
+        return static_cast<Tp*>(ptr);
+#else
+        return static_cast<Tp*>(::operator new(bytes, std::align_val_t { page_size() }));
+#endif
+    }
+
+    static void deallocate(Tp* ptr, std::size_t bytes) noexcept {
+        if (ptr == nullptr) return;
+#if defined(__linux__)
+        munmap(ptr, bytes);
+#else
+        ::operator delete(ptr, std::align_val_t { page_size() });
+#endif
+    }
+
+    void make_partitions(std::size_t workers){
+        const std::size_t record_bytes = std::max<std::size_t>(_record_size * sizeof(Tp), 1), page = page_size(), nodes = _topology.node_count();
+
+        // Boundary k is the first record starting at or after the page boundary nearest below k/workers of the buffer.
+        auto boundary = [&](std::size_t k){
+            if (k == workers) return _records;
+            const std::size_t bytes = _bytes / workers * k + _bytes % workers * k / workers;
+            const std::size_t aligned = bytes / page * page;
+            return std::min((aligned + record_bytes - 1) / record_bytes, _records);
+        };
+
+        _partitions.clear();
+        _partitions.reserve(workers);
+        for (std::size_t w = 0; w < workers; ++w){
+            _partitions.push_back({ w, w * nodes / workers, boundary(w), boundary(w + 1) });
+        }
+    }
+};
@@ -0,0 +1,264 @@
+/**
+ * @file strided_ring_buffer.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <strided_iterator.hpp>
+#include <const_strided_iterator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#ifndef STRIDED_ITERATOR_CACHE_LINE_SIZE
+#define STRIDED_ITERATOR_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief An iterator over one channel of frames stored in a ring, wrapping around its end.
+ *
+ * @tparam Tp Type of the elements (const-qualified for read-only access)
+ *
+ * @note It holds an unwrapped frame index, which is masked by the ring capacity (a power of two) on every access. Use
+ * strided_ring_channel::segments() in hot loops to get plain strided iterators instead.
+ */
+template <typename Tp>
+struct strided_ring_iterator{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = std::remove_const_t<Tp>;
+    using pointer = Tp*;
+    using reference = Tp&;
+    using difference_type = std::ptrdiff_t;
+
+    using self_type = strided_ring_iterator<Tp>;
+
+private:
+    Tp* _data; // element of the channel in the frame 0 of the ring
+    std::size_t _frame;
+    std::size_t _mask;
+    difference_type _stride;
+
+public:
+    // Constructors
+    strided_ring_iterator() noexcept : _data { }, _frame { }, _mask { }, _stride { 1 } { }
+    strided_ring_iterator(Tp* data, std::size_t frame, std::size_t mask, difference_type stride) noexcept : _data { data }, _frame { frame }, _mask { mask }, _stride { stride } { }
+
+    // Accessors
+    difference_type stride() const noexcept { return _stride; }
+
+    // Tp* like operators
+    reference operator*() const noexcept { return _data[static_cast<difference_type>(_frame & _mask) * _stride]; }
+    pointer operator->() const noexcept { return &**this; }
+    reference operator[](difference_type n) const noexcept { return _data[static_cast<difference_type>((_frame + n) & _mask) * _stride]; }
+
+    // Increment / Decrement
+    self_type& operator++() noexcept { ++_frame; return *this; }
+    self_type operator++(int) noexcept { self_type temp { *this }; ++(*this); return temp; }
+    self_type& operator--() noexcept { --_frame; return *this; }
+    self_type operator--(int) noexcept { self_type temp { *this }; --(*this); return temp; }
+
+    // Arithmetic
+    self_type& operator+=(difference_type n) noexcept { _frame += n; return *this; }
+    self_type& operator-=(difference_type n) noexcept { _frame -= n; return *this; }
+    friend self_type operator+(const self_type& iter, difference_type n) noexcept { self_type temp { iter }; temp += n; return temp; }
+    friend self_type operator+(difference_type n, self_type right) noexcept { right += n; return right; }
+    friend self_type operator-(self_type left, difference_type n) noexcept { left -= n; return left; }
+
+    // Difference
+    friend difference_type operator-(const self_type& left, const self_type& right) noexcept { return static_cast<difference_type>(left._frame - right._frame); }
+
+    // Comparison operators (the frame indices may wrap around size_t, so they are compared by their difference)
+    friend bool operator==(const self_type& left, const self_type& right) noexcept { return left._frame == right._frame; }
+    friend bool operator!=(const self_type& left, const self_type& right) noexcept { return left._frame != right._frame; }
+    friend bool operator<(const self_type& left, const self_type& right) noexcept { return left - right < 0; }
+    friend bool operator<=(const self_type& left, const self_type& right) noexcept { return left - right <= 0; }
+    friend bool operator>(const self_type& left, const self_type& right) noexcept { return left - right > 0; }
+    friend bool operator>=(const self_type& left, const self_type& right) noexcept { return left - right >= 0; }
+};
+
+/**
+ * @brief [begin(), end()) of a contiguous run of a channel, i.e. with no wrap point inside.
+ */
+template <typename Iterator>
+struct strided_segment{
+    Iterator first, last;
+
+    Iterator begin() const noexcept { return first; }
+    Iterator end() const noexcept { return last; }
+    std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+    bool empty() const noexcept { return first == last; }
+};
+
+/**
+ * @brief One channel of a strided_ring_frames.
+ */
+template <typename Tp>
+class strided_ring_channel{
+public:
+    using iterator = strided_ring_iterator<Tp>;
+    using segment_iterator = std::conditional_t<std::is_const_v<Tp>, const_strided_iterator<std::remove_const_t<Tp>>, strided_iterator<Tp>>;
+    using segment_type = strided_segment<segment_iterator>;
+
+private:
+    Tp* _data;
+    std::size_t _first, _count, _mask;
+    std::ptrdiff_t _stride;
+
+public:
+    strided_ring_channel(Tp* data, std::size_t first, std::size_t count, std::size_t mask, std::ptrdiff_t stride) noexcept
+        : _data { data }, _first { first }, _count { count }, _mask { mask }, _stride { stride } { }
+
+    iterator begin() const noexcept { return { _data, _first, _mask, _stride }; }
+    iterator end() const noexcept { return { _data, _first + _count, _mask, _stride }; }
+    std::size_t size() const noexcept { return _count; }
+    bool empty() const noexcept { return _count == 0; }
+
+    /**
+     * @brief The channel split at the wrap point of the ring. The second segment is empty if the frames don't wrap around.
+     */
+    std::array<segment_type, 2> segments() const noexcept {
+        const std::size_t start = _first & _mask, head = std::min(_count, _mask + 1 - start);
+        const segment_iterator first { _data + static_cast<std::ptrdiff_t>(start) * _stride, _stride };
+        const segment_iterator second { _data, _stride };
+        return { segment_type { first, first + static_cast<std::ptrdiff_t>(head) }, segment_type { second, second + static_cast<std::ptrdiff_t>(_count - head) } };
+    }
+};
+
+/**
+ * @brief Consecutive frames of a strided_ring_buffer, reserved by the producer or acquired by the consumer.
+ */
+template <typename Tp>
+class strided_ring_frames{
+private:
+    Tp* _data;
+    std::size_t _first, _count, _mask, _channels;
+
+public:
+    strided_ring_frames() noexcept : _data { }, _first { }, _count { }, _mask { }, _channels { } { }
+    strided_ring_frames(Tp* data, std::size_t first, std::size_t count, std::size_t mask, std::size_t channels) noexcept
+        : _data { data }, _first { first }, _count { count }, _mask { mask }, _channels { channels } { }
+
+    // Accessors
+    std::size_t size() const noexcept { return _count; }
+    bool empty() const noexcept { return _count == 0; }
+    std::size_t channels() const noexcept { return _channels; }
+
+    // Element of channel \p channel in the \p frame-th frame
+    Tp& operator()(std::size_t frame, std::size_t channel) const noexcept { return _data[((_first + frame) & _mask) * _channels + channel]; }
+
+    strided_ring_channel<Tp> channel(std::size_t channel) const noexcept { return { _data + channel, _first, _count, _mask, static_cast<std::ptrdiff_t>(_channels) }; }
+};
+
+/**
+ * @brief A lock-free single-producer/single-consumer ring of interleaved frames, each of \p channels elements.
+ *
+ * @tparam Tp Type of the elements
+ *
+ * @note The producer reserve()s free frames, writes them in place and publish()es them; the consumer acquire()s the published frames,
+ * reads them in place and release()s them. Both sides may do it for many frames at once, so the shared indices are touched once per
+ * batch. The indices live on their own cache lines, next to the copy of the other side's index each side last saw, so the producer and
+ * consumer only share a line when the cached copy runs out.
+ */
+template <typename Tp>
+class strided_ring_buffer{
+public:
+    using value_type = Tp;
+    using frames_type = strided_ring_frames<Tp>;
+    using const_frames_type = strided_ring_frames<const Tp>;
+
+private:
+    static constexpr std::size_t cache_line = STRIDED_ITERATOR_CACHE_LINE_SIZE;
+
+    std::vector<Tp> _data;
+    std::size_t _mask, _channels;
+
+    // Producer side
+    alignas(cache_line) std::atomic<std::size_t> _head;
+    std::size_t _cached_tail;
+
+    // Consumer side
+    alignas(cache_line) std::atomic<std::size_t> _tail;
+    std::size_t _cached_head;
+
+public:
+    /**
+     * @param capacity Number of frames, rounded up to a power of two
+     * @param channels Number of elements in each frame (the stride of its channels)
+     */
+    strided_ring_buffer(std::size_t capacity, std::size_t channels)
+        : _data(std::bit_ceil(std::max<std::size_t>(capacity, 1)) * channels), _mask { std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1 }, _channels { channels },
+          _head { 0 }, _cached_tail { 0 }, _tail { 0 }, _cached_head { 0 } { }
+
+    strided_ring_buffer(const strided_ring_buffer&) = delete;
+    strided_ring_buffer& operator=(const strided_ring_buffer&) = delete;
+
+    // Accessors
+    std::size_t capacity() const noexcept { return _mask + 1; }
+    std::size_t channels() const noexcept { return _channels; }
+    // Number of published and not released frames. It is only a snapshot if the other side is running.
+    std::size_t size() const noexcept { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+
+    /**
+     * @brief (Producer) Reserves up to \p frames free frames to be written.
+     *
+     * @return The reserved frames, fewer than \p frames (maybe none) if the ring is full.
+     */
+    frames_type reserve(std::size_t frames) noexcept {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+        if (capacity() - (head - _cached_tail) < frames){
+            _cached_tail = _tail.load(std::memory_order_acquire);
+        }
+        return { _data.data(), head, std::min(frames, capacity() - (head - _cached_tail)), _mask, _channels };
+    }
+
+    /**
+     * @brief (Producer) Makes the first \p frames of the last reserved frames visible to the consumer.
+     */
+    void publish(std::size_t frames) noexcept { _head.store(_head.load(std::memory_order_relaxed) + frames, std::memory_order_release); }
+
+    /**
+     * @brief (Consumer) Acquires up to \p frames published frames to be read.
+     *
+     * @return The oldest published frames, fewer than \p frames (maybe none) if not enough were published.
+     */
+    const_frames_type acquire(std::size_t frames = static_cast<std::size_t>(-1)) noexcept {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+        if (_cached_head - tail < frames){
+            _cached_head = _head.load(std::memory_order_acquire);
+        }
+        return { _data.data(), tail, std::min(frames, _cached_head - tail), _mask, _channels };
+    }
+
+    /**
+     * @brief (Consumer) Gives the first \p frames of the last acquired frames back to the producer.
+     */
+    void release(std::size_t frames) noexcept { _tail.store(_tail.load(std::memory_order_relaxed) + frames, std::memory_order_release); }
+
+    /**
+     * @brief (Producer) Copies up to \p frames interleaved frames from \p src and publishes them.
+     *
+     * @return Number of frames copied.
+     */
+    std::size_t push(const Tp* src, std::size_t frames) noexcept(std::is_nothrow_copy_assignable_v<Tp>) {
+        const frames_type reserved = reserve(frames);
+        const std::size_t start = (_head.load(std::memory_order_relaxed) & _mask), head = std::min(reserved.size(), capacity() - start);
+        std::copy_n(src, head * _channels, _data.data() + start * _channels);
+        std::copy_n(src + head * _channels, (reserved.size() - head) * _channels, _data.data());
+        publish(reserved.size());
+        return reserved.size();
+    }
+};
@@ -0,0 +1,195 @@
+/**
+ * @file strided_scan.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <const_strided_iterator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Statistics computed by strided_fused_scan. Combine them with operator|.
+ */
+enum class strided_statistic : unsigned{
+    min = 1 << 0,
+    max = 1 << 1,
+    mean = 1 << 2,
+    variance = 1 << 3,
+    null_count = 1 << 4,
+    all = min | max | mean | variance | null_count,
+};
+
+constexpr strided_statistic operator|(strided_statistic left, strided_statistic right) noexcept {
+    return static_cast<strided_statistic>(static_cast<unsigned>(left) | static_cast<unsigned>(right));
+}
+
+constexpr bool operator&(strided_statistic left, strided_statistic right) noexcept {
+    return (static_cast<unsigned>(left) & static_cast<unsigned>(right)) != 0;
+}
+
+/**
+ * @brief A channel of an interleaved buffer: its n-th element is at data[Offset + n * Stride].
+ */
+template <std::size_t Offset, std::ptrdiff_t Stride>
+struct strided_channel{
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::ptrdiff_t stride = Stride;
+};
+
+/**
+ * @brief Statistics of a channel. Null elements (NaN, for the floating point types) are excluded from every statistic but null_count.
+ *
+ * @note Statistics not requested are value-initialized. If count is 0, min and max are meaningless and mean and variance are NaN.
+ */
+template <typename Tp>
+struct strided_scan_result{
+    Tp min;
+    Tp max;
+    double mean;
+    double variance; // population variance
+    std::size_t count; // number of non-null elements
+    std::size_t null_count;
+};
+
+namespace strided_scan_detail{
+    // Independent accumulators per channel, so consecutive records don't wait on each other's additions.
+    constexpr std::size_t lanes = 4;
+
+    template <typename Tp>
+    struct accumulator{
+        std::array<Tp, lanes> min, max;
+        std::array<double, lanes> sum, sum_sq;
+        std::array<std::size_t, lanes> null_count;
+        double shift;
+    };
+
+    template <typename Tp>
+    constexpr bool is_null(Tp value) noexcept {
+        if constexpr (std::is_floating_point_v<Tp>) return value != value;
+        else return false;
+    }
+
+    template <typename Tp>
+    constexpr Tp highest() noexcept { return std::numeric_limits<Tp>::has_infinity ? std::numeric_limits<Tp>::infinity() : std::numeric_limits<Tp>::max(); }
+
+    template <typename Tp>
+    constexpr Tp lowest() noexcept { return std::numeric_limits<Tp>::has_infinity ? -std::numeric_limits<Tp>::infinity() : std::numeric_limits<Tp>::lowest(); }
+
+    template <strided_statistic Statistics, typename Tp>
+    void update(accumulator<Tp>& acc, std::size_t lane, Tp value) noexcept {
+        // Branch-free, so the compiler can keep everything in registers and vectorize across lanes.
+        const bool null = is_null(value);
+        if constexpr (Statistics & strided_statistic::min){
+            acc.min[lane] = null ? acc.min[lane] : std::min(acc.min[lane], value);
+        }
+        if constexpr (Statistics & strided_statistic::max){
+            acc.max[lane] = null ? acc.max[lane] : std::max(acc.max[lane], value);
+        }
+        if constexpr ((Statistics & strided_statistic::mean) || (Statistics & strided_statistic::variance)){
+            // Summing value - shift (the first value) keeps the variance accurate when the mean is large compared to the deviation.
+            const double centered = null ? 0.0 : static_cast<double>(value) - acc.shift;
+            acc.sum[lane] += centered;
+            if constexpr (Statistics & strided_statistic::variance){
+                acc.sum_sq[lane] += centered * centered;
+            }
+        }
+        acc.null_count[lane] += null;
+    }
+
+    template <strided_statistic Statistics, typename Tp>
+    strided_scan_result<Tp> finish(const accumulator<Tp>& acc, std::size_t records) noexcept {
+        strided_scan_result<Tp> result { };
+        std::size_t null_count = 0;
+        double sum = 0, sum_sq = 0;
+        for (std::size_t lane = 0; lane < lanes; ++lane){
+            null_count += acc.null_count[lane];
+            sum += acc.sum[lane];
+            sum_sq += acc.sum_sq[lane];
+        }
+        result.count = records - null_count;
+
+        if constexpr (Statistics & strided_statistic::min){
+            result.min = *std::min_element(acc.min.begin(), acc.min.end());
+        }
+        if constexpr (Statistics & strided_statistic::max){
+            result.max = *std::max_element(acc.max.begin(), acc.max.end());
+        }
+        const double count = static_cast<double>(result.count), centered_mean = sum / count;
+        if constexpr (Statistics & strided_statistic::mean){
+            result.mean = centered_mean + acc.shift;
+        }
+        if constexpr (Statistics & strided_statistic::variance){
+            result.variance = std::max(sum_sq / count - centered_mean * centered_mean, 0.0);
+        }
+        if constexpr (Statistics & strided_statistic::null_count){
+            result.null_count = null_count;
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Computes \p Statistics of every channel in \p Channels by reading the buffer once.
+ *
+ * @tparam Statistics Statistics to compute, e.g. strided_statistic::min | strided_statistic::max
+ * @tparam Channels strided_channel<Offset, Stride> of each channel
+ * @param data Interleaved buffer
+ * @param records Number of elements of each channel
+ * @return Statistics of each channel, in the order of \p Channels
+ *
+ * @note The channels are walked together with const_strided_iterator<Tp, Stride>, record by record, so a buffer of records is streamed
+ * through the cache once instead of once per channel and statistic.
+ */
+template <strided_statistic Statistics, typename... Channels, typename Tp>
+std::array<strided_scan_result<Tp>, sizeof...(Channels)> strided_fused_scan(const Tp* data, std::size_t records) noexcept {
+    using namespace strided_scan_detail;
+    static_assert(std::is_arithmetic_v<Tp>, "strided_fused_scan requires arithmetic Tp.");
+    constexpr std::size_t channel_count = sizeof...(Channels);
+
+    std::tuple<const_strided_iterator<Tp, Channels::stride>...> iterators { (data + Channels::offset)... };
+
+    std::array<accumulator<Tp>, channel_count> accumulators { };
+    for (accumulator<Tp>& acc : accumulators){
+        acc.min.fill(highest<Tp>());
+        acc.max.fill(lowest<Tp>());
+    }
+    if (records > 0){
+        [&]<std::size_t... I>(std::index_sequence<I...>){
+            ((accumulators[I].shift = is_null(*std::get<I>(iterators)) ? 0.0 : static_cast<double>(*std::get<I>(iterators))), ...);
+        }(std::make_index_sequence<channel_count> { });
+    }
+
+    [&]<std::size_t... I>(std::index_sequence<I...>){
+        std::size_t r = 0;
+        for (; r + lanes <= records; r += lanes){
+            for (std::size_t lane = 0; lane < lanes; ++lane){
+                const auto n = static_cast<std::ptrdiff_t>(r + lane);
+                (update<Statistics>(accumulators[I], lane, std::get<I>(iterators)[n]), ...);
+            }
+        }
+        for (; r < records; ++r){
+            const auto n = static_cast<std::ptrdiff_t>(r);
+            (update<Statistics>(accumulators[I], 0, std::get<I>(iterators)[n]), ...);
+        }
+    }(std::make_index_sequence<channel_count> { });
+
+    std::array<strided_scan_result<Tp>, channel_count> results;
+    for (std::size_t c = 0; c < channel_count; ++c){
+        results[c] = finish<Statistics>(accumulators[c], records);
+    }
+    return results;
+}
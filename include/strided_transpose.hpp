@@ -0,0 +1,268 @@
+/**
+ * @file strided_transpose.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#pragma once
+
+#include <strided_iterator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__SSE__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Cache parameters used to choose the tile size. Define them before including this header to tune for the target.
+ */
+#ifndef STRIDED_ITERATOR_L1_CACHE_SIZE
+#define STRIDED_ITERATOR_L1_CACHE_SIZE 32768
+#endif
+#ifndef STRIDED_ITERATOR_CACHE_LINE_SIZE
+#define STRIDED_ITERATOR_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * @brief Side length of the square tiles used by strided_transpose and strided_tiles.
+ *
+ * @note A source tile and a destination tile take half of the L1 cache, and the side is a multiple of a cache line, so every line
+ * brought in is fully used before it is evicted.
+ */
+template <typename Tp>
+constexpr std::size_t strided_tile_size() noexcept {
+    constexpr std::size_t line = std::max<std::size_t>(STRIDED_ITERATOR_CACHE_LINE_SIZE / sizeof(Tp), 1);
+    constexpr std::size_t max_elements = STRIDED_ITERATOR_L1_CACHE_SIZE / (4 * sizeof(Tp));
+
+    std::size_t side = 1;
+    while ((side + 1) * (side + 1) <= max_elements) ++side;
+    return std::max(side / line * line, line);
+}
+
+/**
+ * @brief A rectangular part of a 2-D strided region.
+ *
+ * @tparam Tp Type of the elements (may be const)
+ */
+template <typename Tp>
+struct strided_tile{
+    Tp* origin; // top-left element of the tile
+    std::ptrdiff_t stride; // distance between the rows
+    std::size_t row, column; // position of the top-left element in the region
+    std::size_t rows, columns; // size of the tile, smaller than the tile size at the bottom/right edges
+
+    Tp& operator()(std::size_t i, std::size_t j) const noexcept { return origin[static_cast<std::ptrdiff_t>(i) * stride + static_cast<std::ptrdiff_t>(j)]; }
+
+    strided_iterator<Tp, 1> row_begin(std::size_t i) const noexcept { return origin + static_cast<std::ptrdiff_t>(i) * stride; }
+    strided_iterator<Tp, 1> row_end(std::size_t i) const noexcept { return row_begin(i) + static_cast<std::ptrdiff_t>(columns); }
+    strided_iterator<Tp> column_begin(std::size_t j) const noexcept { return { origin + j, stride }; }
+    strided_iterator<Tp> column_end(std::size_t j) const noexcept { return column_begin(j) + static_cast<std::ptrdiff_t>(rows); }
+};
+
+/**
+ * @brief An iterator visiting the tiles of a 2-D strided region in row-major order.
+ *
+ * @tparam Tp Type of the elements (may be const)
+ *
+ * @note Dereferencing returns the tile by value, so it stays valid after the iterator is incremented or destroyed.
+ */
+template <typename Tp>
+struct strided_tile_iterator{
+public:
+    using iterator_category = std::forward_iterator_tag;
+
+    using value_type = strided_tile<Tp>;
+    using pointer = void;
+    using reference = strided_tile<Tp>;
+    using difference_type = std::ptrdiff_t;
+
+    using self_type = strided_tile_iterator<Tp>;
+
+private:
+    std::size_t _rows, _columns;
+    std::size_t _tile_rows, _tile_columns;
+    Tp* _region;
+    strided_tile<Tp> _tile;
+
+public:
+    // Constructors
+    strided_tile_iterator() noexcept : _rows { }, _columns { }, _tile_rows { }, _tile_columns { }, _region { }, _tile { } { }
+    strided_tile_iterator(Tp* region, std::ptrdiff_t stride, std::size_t rows, std::size_t columns, std::size_t tile_rows, std::size_t tile_columns,
+                          std::size_t row = 0) noexcept
+        : _rows { rows }, _columns { columns }, _tile_rows { tile_rows }, _tile_columns { tile_columns }, _region { region }, _tile { } {
+        _tile.stride = stride;
+        // An empty region has no tile, so begin is end.
+        move_to(columns == 0 ? rows : std::min(row, rows), 0);
+    }
+
+    // Tp* like operators
+    reference operator*() const noexcept { return _tile; }
+
+    // Increment
+    self_type& operator++() noexcept {
+        if (_tile.column + _tile_columns < _columns) move_to(_tile.row, _tile.column + _tile_columns);
+        else move_to(std::min(_tile.row + _tile_rows, _rows), 0);
+        return *this;
+    }
+    self_type operator++(int) noexcept { self_type temp { *this }; ++(*this); return temp; }
+
+    // Comparison operators
+    friend bool operator==(const self_type& left, const self_type& right) noexcept { return left._tile.row == right._tile.row && left._tile.column == right._tile.column; }
+    friend bool operator!=(const self_type& left, const self_type& right) noexcept { return !(left == right); }
+
+private:
+    void move_to(std::size_t row, std::size_t column) noexcept {
+        _tile.row = row;
+        _tile.column = column;
+        _tile.rows = std::min(_tile_rows, _rows - row);
+        _tile.columns = std::min(_tile_columns, _columns - column);
+        _tile.origin = _region + static_cast<std::ptrdiff_t>(row) * _tile.stride + static_cast<std::ptrdiff_t>(column);
+    }
+};
+
+/**
+ * @brief Tiles of a 2-D strided region, usable in a range-based for loop.
+ */
+template <typename Tp>
+struct strided_tile_range{
+    strided_tile_iterator<Tp> first, last;
+
+    strided_tile_iterator<Tp> begin() const noexcept { return first; }
+    strided_tile_iterator<Tp> end() const noexcept { return last; }
+};
+
+/**
+ * @brief Splits the region of \p rows x \p columns elements whose rows are \p stride apart into tiles.
+ *
+ * @param region Top-left element of the region
+ * @param stride Distance between the rows of the region
+ * @param tile_rows, tile_columns Size of the tiles (strided_tile_size<Tp>() by default)
+ */
+template <typename Tp>
+strided_tile_range<Tp> strided_tiles(Tp* region, std::ptrdiff_t stride, std::size_t rows, std::size_t columns,
+                                     std::size_t tile_rows = strided_tile_size<std::remove_const_t<Tp>>(), std::size_t tile_columns = strided_tile_size<std::remove_const_t<Tp>>()) noexcept {
+    return {
+        { region, stride, rows, columns, tile_rows, tile_columns },
+        { region, stride, rows, columns, tile_rows, tile_columns, rows },
+    };
+}
+
+namespace strided_transpose_detail{
+    template <typename Tp>
+    constexpr std::size_t micro_size() noexcept {
+        if constexpr (!std::is_trivially_copyable_v<Tp>) return 1;
+#if defined(__AVX__)
+        else if constexpr (sizeof(Tp) == 4) return 8;
+        else if constexpr (sizeof(Tp) == 8) return 4;
+#elif defined(__SSE__)
+        else if constexpr (sizeof(Tp) == 4) return 4;
+#endif
+        else return 1;
+    }
+
+    // Transposes a micro_size<Tp>() square in registers. The bits are only moved, so 4-byte types (float, int32_t, ...) share the float
+    // kernels and 8-byte types the double kernels.
+    template <typename Tp>
+    void micro_transpose(const Tp* src, std::ptrdiff_t src_stride, Tp* dst, std::ptrdiff_t dst_stride) noexcept {
+#if defined(__AVX__)
+        if constexpr (micro_size<Tp>() == 8){
+            auto load = [&](std::ptrdiff_t i){ return _mm256_loadu_ps(reinterpret_cast<const float*>(src + i * src_stride)); };
+            const __m256 r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3), r4 = load(4), r5 = load(5), r6 = load(6), r7 = load(7);
+
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1), t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+            const __m256 t4 = _mm256_unpacklo_ps(r4, r5), t5 = _mm256_unpackhi_ps(r4, r5), t6 = _mm256_unpacklo_ps(r6, r7), t7 = _mm256_unpackhi_ps(r6, r7);
+
+            const __m256 s0 = _mm256_shuffle_ps(t0, t2, 0x44), s1 = _mm256_shuffle_ps(t0, t2, 0xEE), s2 = _mm256_shuffle_ps(t1, t3, 0x44), s3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+            const __m256 s4 = _mm256_shuffle_ps(t4, t6, 0x44), s5 = _mm256_shuffle_ps(t4, t6, 0xEE), s6 = _mm256_shuffle_ps(t5, t7, 0x44), s7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+
+            auto store = [&](std::ptrdiff_t j, __m256 row){ _mm256_storeu_ps(reinterpret_cast<float*>(dst + j * dst_stride), row); };
+            store(0, _mm256_permute2f128_ps(s0, s4, 0x20));
+            store(1, _mm256_permute2f128_ps(s1, s5, 0x20));
+            store(2, _mm256_permute2f128_ps(s2, s6, 0x20));
+            store(3, _mm256_permute2f128_ps(s3, s7, 0x20));
+            store(4, _mm256_permute2f128_ps(s0, s4, 0x31));
+            store(5, _mm256_permute2f128_ps(s1, s5, 0x31));
+            store(6, _mm256_permute2f128_ps(s2, s6, 0x31));
+            store(7, _mm256_permute2f128_ps(s3, s7, 0x31));
+            return;
+        }
+        else if constexpr (micro_size<Tp>() == 4){
+            auto load = [&](std::ptrdiff_t i){ return _mm256_loadu_pd(reinterpret_cast<const double*>(src + i * src_stride)); };
+            const __m256d r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3);
+
+            const __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1), t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+
+            auto store = [&](std::ptrdiff_t j, __m256d row){ _mm256_storeu_pd(reinterpret_cast<double*>(dst + j * dst_stride), row); };
+            store(0, _mm256_permute2f128_pd(t0, t2, 0x20));
+            store(1, _mm256_permute2f128_pd(t1, t3, 0x20));
+            store(2, _mm256_permute2f128_pd(t0, t2, 0x31));
+            store(3, _mm256_permute2f128_pd(t1, t3, 0x31));
+            return;
+        }
+#elif defined(__SSE__)
+        if constexpr (micro_size<Tp>() == 4){
+            auto load = [&](std::ptrdiff_t i){ return _mm_loadu_ps(reinterpret_cast<const float*>(src + i * src_stride)); };
+            __m128 r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            auto store = [&](std::ptrdiff_t j, __m128 row){ _mm_storeu_ps(reinterpret_cast<float*>(dst + j * dst_stride), row); };
+            store(0, r0);
+            store(1, r1);
+            store(2, r2);
+            store(3, r3);
+            return;
+        }
+#endif
+        dst[0] = src[0];
+    }
+
+    template <typename Tp>
+    void transpose_tile(const strided_tile<const Tp>& tile, Tp* dst, std::ptrdiff_t dst_stride) noexcept {
+        constexpr std::size_t micro = micro_size<Tp>();
+
+        std::size_t i = 0;
+        for (; i + micro <= tile.rows; i += micro){
+            std::size_t j = 0;
+            for (; j + micro <= tile.columns; j += micro){
+                micro_transpose(&tile(i, j), tile.stride, dst + static_cast<std::ptrdiff_t>(j) * dst_stride + static_cast<std::ptrdiff_t>(i), dst_stride);
+            }
+            for (; j < tile.columns; ++j){
+                for (std::size_t k = i; k < i + micro; ++k){
+                    dst[static_cast<std::ptrdiff_t>(j) * dst_stride + static_cast<std::ptrdiff_t>(k)] = tile(k, j);
+                }
+            }
+        }
+        for (; i < tile.rows; ++i){
+            for (std::size_t j = 0; j < tile.columns; ++j){
+                dst[static_cast<std::ptrdiff_t>(j) * dst_stride + static_cast<std::ptrdiff_t>(i)] = tile(i, j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Transposes the \p rows x \p cols matrix \p src into the \p cols x \p rows matrix \p dst, i.e. dst[j * dst_stride + i] = src[i * src_stride + j].
+ *
+ * @param src Top-left element of the source
+ * @param src_stride Distance between the rows of the source
+ * @param dst Top-left element of the destination (must not overlap the source)
+ * @param dst_stride Distance between the rows of the destination
+ *
+ * @note The source is visited tile by tile (see strided_tile_size), so the columns written to the destination stay in the cache
+ * until they are complete. Inside a tile, 8x8 (4-byte types) or 4x4 (8-byte types) squares are transposed in AVX registers,
+ * or 4x4 squares of 4-byte types in SSE registers if AVX is not enabled.
+ */
+template <typename Tp>
+void strided_transpose(const Tp* src, std::ptrdiff_t src_stride, Tp* dst, std::ptrdiff_t dst_stride, std::size_t rows, std::size_t cols) noexcept {
+    for (const strided_tile<const Tp>& tile : strided_tiles(src, src_stride, rows, cols)){
+        strided_transpose_detail::transpose_tile(tile, dst + static_cast<std::ptrdiff_t>(tile.column) * dst_stride + static_cast<std::ptrdiff_t>(tile.row), dst_stride);
+    }
+}
@@ -0,0 +1,243 @@
+/**
+ * @file bit_strided_iterator_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of bit_strided_iterator
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <bit_strided_iterator.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#if __cplusplus > 201703L
+TEST(BitStridedIterator, IsRandomAccessIterator){
+    constexpr auto is_random_access_iterator = std::random_access_iterator<bit_strided_iterator<std::uint16_t, 12, 48>>;
+    EXPECT_TRUE(is_random_access_iterator);
+
+    constexpr auto is_random_access_iterator2 = std::random_access_iterator<bit_strided_iterator<int>>;
+    EXPECT_TRUE(is_random_access_iterator2);
+
+    constexpr auto is_contiguous_iterator = std::contiguous_iterator<bit_strided_iterator<std::uint8_t, 8, 8>>;
+    EXPECT_FALSE(is_contiguous_iterator);
+
+    constexpr auto is_const_random_access_iterator = std::random_access_iterator<const_bit_strided_iterator<std::uint16_t, 12, 48>>;
+    EXPECT_TRUE(is_const_random_access_iterator);
+
+    constexpr auto is_const_random_access_iterator2 = std::random_access_iterator<const_bit_strided_iterator<int>>;
+    EXPECT_TRUE(is_const_random_access_iterator2);
+}
+#endif
+
+TEST(bit_strided_iterator_with_template_parameters, ForLoopOutputTest){
+    // 12-bit values every 48 bits: 0xABC, 0x123, 0xFFF, 0x001 with junk in between
+    std::array<std::uint16_t, 16> words { 0xDABC, 0xBEEF, 0xCAFE, 0x5123, 0x1111, 0x2222, 0x0FFF, 0x3333, 0x4444, 0xE001, 0x5555, 0x6666 };
+
+    std::vector<std::uint16_t> v1;
+    for (bit_strided_iterator<std::uint16_t, 12, 48> it { words.data() }, last = it + 4; it != last; ++it){
+        v1.push_back(*it);
+    }
+    EXPECT_THAT(v1, ::testing::ElementsAreArray({ 0xABC, 0x123, 0xFFF, 0x001 }));
+
+    // 4-bit nibbles starting from bit 4 of each byte
+    std::array<std::uint8_t, 4> bytes { 0x21, 0x43, 0x65, 0x87 };
+    std::vector<int> v2;
+    for (bit_strided_iterator<std::uint8_t, 4, 8> it { bytes.data(), 4 }, last = it + 4; it != last; ++it){
+        v2.push_back(*it);
+    }
+    EXPECT_THAT(v2, ::testing::ElementsAreArray({ 2, 4, 6, 8 }));
+
+    // signed 3-bit values are sign-extended
+    std::array<std::uint8_t, 2> packed { 0b10'111'011, 0b0000000'1 }; // 3, -1, -2 (the last one crosses the byte boundary)
+    bit_strided_iterator<std::int8_t, 3, 3> first { packed.data() };
+    EXPECT_EQ(first[0], 3);
+    EXPECT_EQ(first[1], -1);
+    EXPECT_EQ(first[2], -2);
+
+    // with negative stride, starts from the last nibble
+    std::vector<int> v3;
+    for (bit_strided_iterator<std::uint8_t, 4, -8> it { bytes.data(), 3 * 8 }; it >= bit_strided_iterator<std::uint8_t, 4, -8> { bytes.data() }; ++it){
+        v3.push_back(*it);
+    }
+    EXPECT_THAT(v3, ::testing::ElementsAreArray({ 7, 5, 3, 1 }));
+}
+
+TEST(bit_strided_iterator_with_template_parameters, ForLoopInputTest){
+    std::array<std::uint8_t, 6> bytes { };
+    std::fill(bytes.begin(), bytes.end(), 0xFF);
+
+    // write 5-bit fields every 7 bits, bits in between must be kept
+    int i = 0;
+    for (bit_strided_iterator<unsigned, 5, 7> it { bytes.data() }, last = it + 6; it != last; ++it, ++i){
+        *it = i;
+    }
+
+    bit_strided_iterator<unsigned, 5, 7> first { bytes.data() };
+    for (i = 0; i < 6; ++i){
+        EXPECT_EQ(first[i], static_cast<unsigned>(i));
+    }
+    bit_strided_iterator<unsigned, 2, 7> gaps { bytes.data(), 5 };
+    for (i = 0; i < 6; ++i){
+        EXPECT_EQ(gaps[i], 3U);
+    }
+}
+
+TEST(bit_strided_iterator_with_template_parameters, STLCompatibilityTest){
+    std::vector<std::uint8_t> bytes(12);
+    bit_strided_iterator<int, 6, 8> first { bytes.data(), 1 }, last = first + 12;
+
+    std::iota(first, last, 20);
+    EXPECT_EQ(last - first, 12);
+    EXPECT_EQ(std::accumulate(first, last, 0), 20 * 12 + 66);
+    EXPECT_EQ(*std::max_element(first, last), 31);
+    EXPECT_EQ(std::count_if(first, last, [](int x){ return x % 2 == 0; }), 6);
+
+    const std::vector<int> unpacked(first, last);
+    std::reverse_copy(unpacked.begin(), unpacked.end(), first);
+    EXPECT_EQ(*first, 31);
+    EXPECT_EQ(first[11], 20);
+
+    // Swapping algorithms go through the swap of the proxy references
+    std::sort(first, last);
+    EXPECT_TRUE(std::is_sorted(first, last));
+    EXPECT_EQ(*first, 20);
+    std::reverse(first, last);
+    EXPECT_EQ(*first, 31);
+    EXPECT_EQ(first[11], 20);
+    std::iter_swap(first, first + 11);
+    EXPECT_EQ(*first, 20);
+    EXPECT_EQ(first[11], 31);
+    int value = 7;
+    swap(first[1], value);
+    EXPECT_EQ(first[1], 7);
+    EXPECT_EQ(value, 30);
+
+    // Fields sharing bytes, with bits in between left untouched
+    std::vector<std::uint8_t> packed(10, 0xFF);
+    bit_strided_iterator<unsigned, 5, 7> packed_first { packed.data() };
+    const std::array<unsigned, 10> values { 17, 3, 31, 0, 9, 22, 5, 12, 28, 1 };
+    std::copy(values.begin(), values.end(), packed_first);
+    std::sort(packed_first, packed_first + 10);
+    EXPECT_THAT(std::vector<unsigned>(packed_first, packed_first + 10), ::testing::ElementsAreArray({ 0, 1, 3, 5, 9, 12, 17, 22, 28, 31 }));
+    for (std::size_t bit = 0; bit < 70; ++bit){
+        if (bit % 7 >= 5){
+            EXPECT_EQ((packed[bit / 8] >> (bit % 8)) & 1, 1) << bit;
+        }
+    }
+#if __cplusplus > 201703L
+    std::ranges::sort(packed_first, packed_first + 10, std::greater<> { });
+    EXPECT_EQ(*packed_first, 31U);
+#endif
+}
+
+TEST(bit_strided_iterator_without_template_parameters, ForLoopOutputTest){
+    std::array<std::uint16_t, 16> words { 0xDABC, 0xBEEF, 0xCAFE, 0x5123, 0x1111, 0x2222, 0x0FFF, 0x3333, 0x4444, 0xE001, 0x5555, 0x6666 };
+
+    std::vector<std::uint16_t> v1;
+    for (bit_strided_iterator<std::uint16_t> it { words.data(), 12, 48 }, last = it + 4; it != last; ++it){
+        v1.push_back(*it);
+    }
+    EXPECT_THAT(v1, ::testing::ElementsAreArray({ 0xABC, 0x123, 0xFFF, 0x001 }));
+
+    // 60-bit fields every 61 bits span 9 bytes
+    std::vector<std::uint8_t> bytes(64);
+    bit_strided_iterator<std::int64_t> first { bytes.data(), 60, 61, 3 };
+    const std::array<std::int64_t, 4> values { -1, 0x0123456789ABCDEF >> 4, -(std::int64_t { 1 } << 59), 42 };
+    std::copy(values.begin(), values.end(), first);
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), first));
+
+    std::sort(first, first + 4);
+    EXPECT_THAT(std::vector<std::int64_t>(first, first + 4), ::testing::ElementsAre(-(std::int64_t { 1 } << 59), -1, 42, 0x0123456789ABCDEF >> 4));
+}
+
+TEST(const_bit_strided_iterator, ConstBufferTest){
+    const std::array<std::uint16_t, 16> words { 0xDABC, 0xBEEF, 0xCAFE, 0x5123, 0x1111, 0x2222, 0x0FFF, 0x3333, 0x4444, 0xE001, 0x5555, 0x6666 };
+
+    const_bit_strided_iterator<std::uint16_t, 12, 48> first { words.data() }, last = first + 4;
+    EXPECT_THAT(std::vector<std::uint16_t>(first, last), ::testing::ElementsAreArray({ 0xABC, 0x123, 0xFFF, 0x001 }));
+    EXPECT_EQ(*std::max_element(first, last), 0xFFF);
+    EXPECT_EQ(last - first, 4);
+    EXPECT_EQ(first[2], 0xFFF);
+
+    const_bit_strided_iterator<std::uint16_t> it { words.data(), 12, 48 };
+    EXPECT_TRUE(std::equal(first, last, it));
+    EXPECT_EQ((it + 4) - it, 4);
+
+    // Signed fields are sign-extended, and mutable iterators convert to const ones.
+    std::vector<std::uint8_t> bytes(8);
+    bit_strided_iterator<int, 6, 8> output { bytes.data(), 1 };
+    const std::array<int, 4> values { -32, -1, 0, 31 };
+    std::copy(values.begin(), values.end(), output);
+    const_bit_strided_iterator<int, 6, 8> input = output;
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), input));
+
+    const_bit_strided_iterator<int> runtime_input = bit_strided_iterator<int> { bytes.data(), 6, 8, 1 };
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), runtime_input));
+}
+
+TEST(bit_strided_pack, UnpackPackRoundTripTest){
+    for (std::ptrdiff_t bit_offset : { 0, 3, 8, 13 }){
+        std::vector<std::uint16_t> values(1000);
+        for (std::size_t i = 0; i < values.size(); ++i){
+            values[i] = static_cast<std::uint16_t>((i * 2654435761U) & 0xFFF);
+        }
+
+        // 12-bit values every 48 bits
+        std::vector<std::uint8_t> packed((bit_offset + values.size() * 48 + 7) / 8, 0xA5);
+        const std::vector<std::uint8_t> original = packed;
+        bit_pack<std::uint16_t, 12, 48>(values.data(), values.size(), packed.data(), bit_offset);
+
+        std::vector<std::uint16_t> unpacked(values.size());
+        bit_unpack<std::uint16_t, 12, 48>(packed.data(), unpacked.size(), unpacked.data(), bit_offset);
+        EXPECT_EQ(unpacked, values);
+
+        std::fill(unpacked.begin(), unpacked.end(), 0);
+        bit_unpack<std::uint16_t>(packed.data(), unpacked.size(), unpacked.data(), 12, 48, bit_offset);
+        EXPECT_EQ(unpacked, values);
+
+        // the bits between fields are untouched
+        std::vector<std::uint8_t> original_copy = original;
+        bit_strided_iterator<std::uint64_t, 36, 48> gaps { packed.data(), bit_offset + 12 }, original_gaps { original_copy.data(), bit_offset + 12 };
+        EXPECT_TRUE(std::equal(gaps, gaps + (values.size() - 1), original_gaps));
+    }
+
+    // word-at-a-time path with a partially filled last word: 4-bit values every 32 bits
+    std::array<std::uint32_t, 3> sparse { 1, 2, 3 };
+    std::vector<std::uint8_t> sparse_packed(9, 0xFF); // exactly the bytes spanned by the fields
+    bit_pack<std::uint32_t, 4, 32>(sparse.data(), sparse.size(), sparse_packed.data());
+    EXPECT_THAT(sparse_packed, ::testing::ElementsAreArray({ 0xF1, 0xFF, 0xFF, 0xFF, 0xF2, 0xFF, 0xFF, 0xFF, 0xF3 }));
+    std::array<std::uint32_t, 3> sparse_unpacked { };
+    bit_unpack<std::uint32_t, 4, 32>(sparse_packed.data(), sparse_unpacked.size(), sparse_unpacked.data());
+    EXPECT_EQ(sparse_unpacked, sparse);
+
+    // word-at-a-time path: 4-bit values every 8 bits, and the tail stays inside the buffer
+    std::vector<std::uint8_t> nibbles(37);
+    std::iota(nibbles.begin(), nibbles.end(), 0);
+    std::vector<std::uint8_t> packed(nibbles.size(), 0xF0);
+    bit_pack<std::uint8_t, 4, 8>(nibbles.data(), nibbles.size(), packed.data());
+    for (std::size_t i = 0; i < packed.size(); ++i){
+        EXPECT_EQ(packed[i], 0xF0 | (i & 0xF));
+    }
+    std::vector<std::uint8_t> unpacked(nibbles.size());
+    bit_unpack<std::uint8_t, 4, 8>(packed.data(), unpacked.size(), unpacked.data());
+    for (std::size_t i = 0; i < unpacked.size(); ++i){
+        EXPECT_EQ(unpacked[i], i & 0xF);
+    }
+
+    // signed runtime variant
+    std::vector<int> signed_values { -8, 7, -1, 0, 3, -5 };
+    std::vector<std::uint8_t> signed_packed(3);
+    bit_pack<int>(signed_values.data(), signed_values.size(), signed_packed.data(), 4, 4);
+    std::vector<int> signed_unpacked(signed_values.size());
+    bit_unpack<int>(signed_packed.data(), signed_unpacked.size(), signed_unpacked.data(), 4, 4);
+    EXPECT_EQ(signed_unpacked, signed_values);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file strided_batch_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of load_batch/store_batch
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_batch.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+template <typename Batch>
+std::vector<typename Batch::value_type> to_vector(const Batch& batch){
+    std::vector<typename Batch::value_type> result(batch.size());
+    for (std::size_t k = 0; k < result.size(); ++k){
+        result[k] = batch[k];
+    }
+    return result;
+}
+
+TEST(strided_batch_with_stride_template_parameter, LoadTest){
+    std::vector<int> v(64);
+    std::iota(v.begin(), v.end(), 0);
+
+    // with stride 1
+    EXPECT_THAT(to_vector(load_batch<8>(strided_iterator<int, 1> { v.data() })), ::testing::ElementsAreArray({ 0, 1, 2, 3, 4, 5, 6, 7 }));
+
+    // with stride 3, starts from v.data() + 1
+    EXPECT_THAT(to_vector(load_batch<4>(strided_iterator<int, 3> { v.data() + 1 })), ::testing::ElementsAreArray({ 1, 4, 7, 10 }));
+
+    // with stride -2, starts from the rear of v
+    EXPECT_THAT(to_vector(load_batch<4>(const_strided_iterator<int, -2> { v.data() + 63 })), ::testing::ElementsAreArray({ 63, 61, 59, 57 }));
+
+    // masked tail: only the first 3 of 4 lanes, the 4th element would be out of v
+    EXPECT_THAT(to_vector(load_batch<4>(const_strided_iterator<int, 4> { v.data() + 55 }, 3)), ::testing::ElementsAreArray({ 55, 59, 63, 0 }));
+}
+
+TEST(strided_batch_with_stride_template_parameter, StoreTest){
+    std::vector<double> v(16);
+
+    strided_batch<double, 4> batch = load_batch<4>(const_strided_iterator<double, 1> { std::array<double, 4> { 1, 2, 3, 4 }.data() });
+    store_batch<4>(strided_iterator<double, 4> { v.data() }, batch);
+    EXPECT_THAT(v, ::testing::ElementsAreArray({ 1, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0 }));
+
+    store_batch<4>(strided_iterator<double, 1> { v.data() + 1 }, batch);
+    EXPECT_THAT(v, ::testing::ElementsAreArray({ 1, 1, 2, 3, 4, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0 }));
+
+    // masked tail
+    store_batch<4>(strided_iterator<double, 5> { v.data() + 5 }, batch, 2);
+    EXPECT_THAT(v, ::testing::ElementsAreArray({ 1, 1, 2, 3, 4, 1, 0, 0, 3, 0, 2, 0, 4, 0, 0, 0 }));
+}
+
+TEST(strided_batch_without_stride_template_parameter, LoadTest){
+    std::vector<std::int32_t> i32(256);
+    std::iota(i32.begin(), i32.end(), 0);
+    std::vector<float> f32(i32.begin(), i32.end());
+    std::vector<double> f64(i32.begin(), i32.end());
+    std::vector<std::int64_t> i64(i32.begin(), i32.end());
+
+    // batches filling a 256-bit register, gathered if AVX2 is enabled
+    EXPECT_THAT(to_vector(load_batch<8>(strided_iterator<std::int32_t> { i32.data() + 2, 5 })), ::testing::ElementsAreArray({ 2, 7, 12, 17, 22, 27, 32, 37 }));
+    EXPECT_THAT(to_vector(load_batch<8>(const_strided_iterator<float> { f32.data() + 255, -3 })), ::testing::ElementsAreArray({ 255, 252, 249, 246, 243, 240, 237, 234 }));
+    EXPECT_THAT(to_vector(load_batch<4>(const_strided_iterator<double> { f64.data(), 64 })), ::testing::ElementsAreArray({ 0, 64, 128, 192 }));
+    EXPECT_THAT(to_vector(load_batch<4>(strided_iterator<std::int64_t> { i64.data() + 10, 7 })), ::testing::ElementsAreArray({ 10, 17, 24, 31 }));
+
+    // other sizes
+    EXPECT_THAT(to_vector(load_batch<3>(strided_iterator<std::int32_t> { i32.data(), 100 })), ::testing::ElementsAreArray({ 0, 100, 200 }));
+
+    // masked tail
+    EXPECT_THAT(to_vector(load_batch<8>(const_strided_iterator<float> { f32.data() + 240, 8 }, 2)), ::testing::ElementsAreArray({ 240, 248, 0, 0, 0, 0, 0, 0 }));
+}
+
+TEST(strided_batch_without_stride_template_parameter, StoreTest){
+    std::vector<float> v(12);
+
+    const std::array<float, 4> values { 1, 2, 3, 4 };
+    strided_batch<float, 4> batch = load_batch<4>(const_strided_iterator<float> { values.data(), 1 });
+    store_batch<4>(strided_iterator<float> { v.data() + 2, 3 }, batch);
+    EXPECT_THAT(v, ::testing::ElementsAreArray({ 0, 0, 1, 0, 0, 2, 0, 0, 3, 0, 0, 4 }));
+
+    // masked tail
+    store_batch<4>(strided_iterator<float> { v.data() + 11, -5 }, batch, 3);
+    EXPECT_THAT(v, ::testing::ElementsAreArray({ 0, 3, 1, 0, 0, 2, 2, 0, 3, 0, 0, 1 }));
+}
+
+TEST(strided_batch, NonArithmeticTypeTest){
+    struct point { int x, y; };
+    std::vector<point> v { { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 } };
+
+    auto batch = load_batch<2>(strided_iterator<point, 2> { v.data() + 1 });
+    static_assert(std::is_same_v<decltype(batch), std::array<point, 2>>);
+    EXPECT_EQ(batch[0].x, 2);
+    EXPECT_EQ(batch[1].y, 7);
+}
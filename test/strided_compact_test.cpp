@@ -0,0 +1,135 @@
+/**
+ * @file strided_compact_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of strided_compact and strided_stable_partition
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_compact.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#pragma pack(push, 1)
+struct record{
+    std::uint32_t id;
+    std::uint8_t flags;
+    std::int16_t key; // unaligned
+    float value;
+
+    friend bool operator==(const record&, const record&) = default;
+};
+#pragma pack(pop)
+
+static std::vector<record> make_records(std::size_t count){
+    std::vector<record> records(count);
+    for (std::size_t i = 0; i < count; ++i){
+        records[i] = { static_cast<std::uint32_t>(i), static_cast<std::uint8_t>(i % 7), static_cast<std::int16_t>((i * 2654435761U) % 200 - 100), static_cast<float>(i) / 2 };
+    }
+    return records;
+}
+
+TEST(strided_compact, CompactTest){
+    auto is_positive = [](std::int16_t key){ return key > 0; };
+    for (std::size_t count : { 0, 1, 63, 64, 65, 1000 }){
+        const std::vector<record> records = make_records(count);
+        std::vector<record> expected;
+        std::copy_if(records.begin(), records.end(), std::back_inserter(expected), [&](const record& r){ return is_positive(r.key); });
+
+        // out-of-place
+        std::vector<record> dst(count);
+        const std::size_t copied = strided_compact_copy<std::int16_t>(records.data(), count, sizeof(record), offsetof(record, key), dst.data(), is_positive);
+        dst.resize(copied);
+        EXPECT_EQ(dst, expected);
+
+        // in-place
+        std::vector<record> in_place = records;
+        const std::size_t kept = strided_compact<std::int16_t>(in_place.data(), count, sizeof(record), offsetof(record, key), is_positive);
+        in_place.resize(kept);
+        EXPECT_EQ(in_place, expected);
+    }
+}
+
+TEST(strided_compact, AllOrNoneTest){
+    std::vector<record> records = make_records(130);
+    const std::vector<record> original = records;
+
+    EXPECT_EQ(strided_compact<std::uint32_t>(records.data(), records.size(), sizeof(record), offsetof(record, id), [](std::uint32_t){ return true; }), 130U);
+    EXPECT_EQ(records, original);
+
+    EXPECT_EQ(strided_compact<std::uint32_t>(records.data(), records.size(), sizeof(record), offsetof(record, id), [](std::uint32_t){ return false; }), 0U);
+
+    // key of another type: every other record by id
+    records = original;
+    EXPECT_EQ(strided_compact<std::uint32_t>(records.data(), records.size(), sizeof(record), offsetof(record, id), [](std::uint32_t id){ return id % 2 == 1; }), 65U);
+    EXPECT_EQ(records[64].id, 129U);
+}
+
+TEST(strided_stable_partition, PartitionTest){
+    auto is_small = [](float value){ return value < 100 || value > 400; };
+    for (std::size_t count : { 0, 1, 64, 77, 1000 }){
+        std::vector<record> records = make_records(count), expected = records;
+        const auto expected_point = std::stable_partition(expected.begin(), expected.end(), [&](const record& r){ return is_small(r.value); }) - expected.begin();
+
+        const std::size_t point = strided_stable_partition<float>(records.data(), count, sizeof(record), offsetof(record, value), is_small);
+        EXPECT_EQ(point, static_cast<std::size_t>(expected_point));
+        EXPECT_EQ(records, expected);
+    }
+}
+
+TEST(strided_compact, RandomSelectionTest){
+    // 16 byte records use the fixed-size moves, 13 byte ones the runtime-size moves
+    for (std::size_t record_size : { 16, 13 }){
+        std::mt19937 generator { 42 };
+        std::uniform_int_distribution<int> distribution { 0, 255 };
+        constexpr std::size_t count = 5000;
+        std::vector<unsigned char> records(count * record_size);
+        std::generate(records.begin(), records.end(), [&]{ return static_cast<unsigned char>(distribution(generator)); });
+        // last records rejected, so the copy of a rejected record lands past the last kept one
+        for (std::size_t i = count - 3; i < count; ++i) records[i * record_size + 1] = 0;
+
+        auto is_selected = [](std::uint8_t key){ return key >= 128; };
+        std::vector<unsigned char> expected;
+        for (std::size_t i = 0; i < count; ++i){
+            if (is_selected(records[i * record_size + 1])){
+                expected.insert(expected.end(), records.begin() + i * record_size, records.begin() + (i + 1) * record_size);
+            }
+        }
+        const std::size_t kept = expected.size() / record_size;
+
+        // room for one more record than selected is enough
+        std::vector<unsigned char> dst((kept + 1) * record_size);
+        EXPECT_EQ(strided_compact_copy<std::uint8_t>(records.data(), count, record_size, 1, dst.data(), is_selected), kept);
+        dst.resize(kept * record_size);
+        EXPECT_EQ(dst, expected);
+
+        std::vector<unsigned char> in_place = records;
+        EXPECT_EQ(strided_compact<std::uint8_t>(in_place.data(), count, record_size, 1, is_selected), kept);
+        in_place.resize(kept * record_size);
+        EXPECT_EQ(in_place, expected);
+
+        std::vector<unsigned char> partitioned = records;
+        EXPECT_EQ(strided_stable_partition<std::uint8_t>(partitioned.data(), count, record_size, 1, is_selected), kept);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), partitioned.begin()));
+    }
+}
+
+TEST(strided_compact, LongRunTest){
+    // runs of 100 records take the run-by-run moves
+    std::vector<record> records = make_records(1000), expected;
+    std::copy_if(records.begin(), records.end(), std::back_inserter(expected), [](const record& r){ return r.id / 100 % 2 == 0; });
+    EXPECT_EQ(strided_compact<std::uint32_t>(records.data(), records.size(), sizeof(record), offsetof(record, id), [](std::uint32_t id){ return id / 100 % 2 == 0; }), expected.size());
+    records.resize(expected.size());
+    EXPECT_EQ(records, expected);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file strided_histogram_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of strided_histogram and strided_count_if
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_histogram.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+// Reference histogram with a plain loop.
+template <typename Iterator>
+std::vector<std::size_t> naive_histogram(Iterator first, Iterator last){
+    using Tp = typename std::iterator_traits<Iterator>::value_type;
+    std::vector<std::size_t> histogram(std::size_t { 1 } << (sizeof(Tp) * CHAR_BIT));
+    for (; first != last; ++first){
+        ++histogram[static_cast<std::make_unsigned_t<Tp>>(*first)];
+    }
+    return histogram;
+}
+
+TEST(strided_histogram, SingleChannelTest){
+    std::vector<std::uint8_t> rgba(4 * 1001);
+    for (std::size_t i = 0; i < rgba.size(); ++i){
+        rgba[i] = static_cast<std::uint8_t>(i % 4 == 3 ? 255 : (i * 7) % 13); // alpha is a long run of the same value
+    }
+
+    // with stride template parameter
+    const_strided_iterator<std::uint8_t, 4> alpha_first { rgba.data() + 3 }, alpha_last { rgba.data() + 3 + rgba.size() };
+    std::vector<std::size_t> alpha = strided_histogram(alpha_first, alpha_last);
+    EXPECT_EQ(alpha[255], 1001U);
+    EXPECT_EQ(std::accumulate(alpha.begin(), alpha.end(), std::size_t { 0 }), 1001U);
+
+    // without stride template parameter
+    const_strided_iterator<std::uint8_t> green_first { rgba.data() + 1, 4 }, green_last { rgba.data() + 1 + rgba.size(), 4 };
+    EXPECT_EQ(strided_histogram(green_first, green_last), naive_histogram(green_first, green_last));
+
+    // signed values are binned by their bit pattern
+    std::vector<std::int16_t> samples { -1, 0, 1, -1, -32768, 7, -1 };
+    std::vector<std::size_t> histogram = strided_histogram(strided_iterator<std::int16_t, 1> { samples.data() }, strided_iterator<std::int16_t, 1> { samples.data() + samples.size() });
+    EXPECT_EQ(histogram.size(), 65536U);
+    EXPECT_EQ(histogram[0xFFFF], 3U);
+    EXPECT_EQ(histogram[0x8000], 1U);
+    EXPECT_EQ(histogram[7], 1U);
+}
+
+TEST(strided_histogram, MultiChannelTest){
+    constexpr std::size_t channels = 3, records = 517;
+    std::vector<std::uint16_t> interleaved(channels * records);
+    for (std::size_t i = 0; i < interleaved.size(); ++i){
+        interleaved[i] = static_cast<std::uint16_t>((i * 2654435761U) >> (i % channels * 4));
+    }
+
+    std::vector<std::vector<std::size_t>> histograms = strided_histogram(interleaved.data(), records, channels);
+    ASSERT_EQ(histograms.size(), channels);
+    for (std::size_t c = 0; c < channels; ++c){
+        const_strided_iterator<std::uint16_t> first { interleaved.data() + c, channels }, last { interleaved.data() + c + interleaved.size(), channels };
+        EXPECT_EQ(histograms[c], naive_histogram(first, last));
+    }
+}
+
+TEST(strided_histogram, ParallelTest){
+    std::vector<std::uint8_t> v(3 * 100003);
+    for (std::size_t i = 0; i < v.size(); ++i){
+        v[i] = static_cast<std::uint8_t>((i * i) % 251);
+    }
+
+    const_strided_iterator<std::uint8_t, 3> first { v.data() + 2 }, last { v.data() + 2 + v.size() };
+    const std::vector<std::size_t> expected = naive_histogram(first, last);
+    for (unsigned thread_count : { 0U, 1U, 3U, 8U }){
+        EXPECT_EQ(strided_histogram_parallel(first, last, thread_count), expected);
+    }
+
+    // fewer elements than threads
+    EXPECT_EQ(strided_histogram_parallel(first, first + 2, 4)[(2 * 2) % 251], 1U);
+    const std::vector<std::size_t> empty = strided_histogram_parallel(first, first, 4);
+    EXPECT_EQ(std::accumulate(empty.begin(), empty.end(), std::size_t { 0 }), 0U);
+}
+
+TEST(strided_count_if, CountTest){
+    std::vector<int> v { 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11 };
+
+    auto is_positive = [](int x){ return x > 0; };
+    EXPECT_EQ(strided_count_if(strided_iterator<int, 1> { v.data() }, strided_iterator<int, 1> { v.data() + v.size() }, is_positive), 6U);
+    EXPECT_EQ(strided_count_if(strided_iterator<int, 2> { v.data() + 1 }, strided_iterator<int, 2> { v.data() + 11 }, is_positive), 0U);
+    EXPECT_EQ(strided_count_if(const_strided_iterator<int> { v.data(), 3 }, const_strided_iterator<int> { v.data() + 12, 3 }, [](int x){ return x % 2 != 0; }), 2U);
+}
@@ -15,6 +15,9 @@
 #include <algorithm>
 #include <numeric>
 #include <array>
+#if __cplusplus > 201703L
+#include <span>
+#endif
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -140,6 +143,16 @@ TEST(strided_iterator_with_stride_template_parameter, STLCompatibilityTest){
     int even_sum = std::accumulate<strided_iterator<int, 2>, int>(v.begin() + 1, v.end() + 1, 0);
     EXPECT_EQ(even_sum, -30);
 
+    // Difference
+
+    strided_iterator<int, 2> forward_first { v.begin() }, forward_last = forward_first + 5;
+    EXPECT_EQ(forward_last - forward_first, 5);
+    EXPECT_EQ(forward_first - forward_last, -5);
+
+    strided_iterator<int, -2> backward_first { v.begin() + 8 }, backward_last = backward_first + 4;
+    EXPECT_EQ(backward_last - backward_first, 4);
+    EXPECT_EQ(backward_first - backward_last, -4);
+
     // Sorting
 
     std::sort<strided_iterator<int, 2>>(v.begin(), v.end(), std::greater<int>());
@@ -267,6 +280,18 @@ TEST(strided_iterator_without_stride_template_parameter, STLCompatibilityTest){
     int even_sum = std::accumulate(strided_iterator<int>{ v.begin() + 1, 2 }, strided_iterator<int>{ v.end() + 1, 2 }, 0);
     EXPECT_EQ(even_sum, -30);
 
+    // Difference
+
+    for (std::ptrdiff_t stride : { 1, 2, 3 }){
+        strided_iterator<int> forward_first { v.begin(), stride }, forward_last { v.begin() + 3 * stride, stride };
+        EXPECT_EQ(forward_last - forward_first, 3);
+        EXPECT_EQ(forward_first - forward_last, -3);
+
+        strided_iterator<int> backward_first { v.begin() + 3 * stride, -stride }, backward_last { v.begin(), -stride };
+        EXPECT_EQ(backward_last - backward_first, 3);
+        EXPECT_EQ(backward_first - backward_last, -3);
+    }
+
     // Sorting
 
     std::sort(strided_iterator<int>{ v.begin(), 2 }, strided_iterator<int>{ v.end(), 2 }, std::greater<int>());
@@ -297,4 +322,38 @@ TEST(strided_iterator_without_stride_template_parameter, STLCompatibilityTest){
         5, 27, -2, 12, 
         -1, 6, 0, 6,
     }));
-}
\ No newline at end of file
+}
+
+#if __cplusplus > 201703L
+TEST(strided_iterator, ContiguousSourceTest){
+    std::vector<int> v { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    std::span<int> span { v };
+
+    // from iterators of any contiguous container or view
+    strided_iterator<int, 3> it1 = span.begin() + 1;
+    EXPECT_THAT(std::vector<int>(it1, it1 + 3), ::testing::ElementsAreArray({ 2, 5, 8 }));
+    strided_iterator<int> it2 { span.end() - 1, -4 };
+    EXPECT_THAT(std::vector<int>(it2, it2 + 3), ::testing::ElementsAreArray({ 9, 5, 1 }));
+
+    // from a raw buffer, offset and stride (records of 3 channels, channel 2)
+    EXPECT_THAT(std::vector<int>(make_strided_iterator<3>(v.data(), 2), make_strided_iterator<3>(v.data(), 2) + 3), ::testing::ElementsAreArray({ 3, 6, 9 }));
+    EXPECT_EQ(make_strided_iterator(v.data(), 0, 4)[2], 9);
+
+    // from contiguous ranges
+    int array[] { 10, 20, 30, 40 };
+    EXPECT_EQ(*(make_strided_iterator<2>(array, 1) + 1), 40);
+    EXPECT_EQ(make_strided_iterator<2>(span, 1)[3], 8);
+    EXPECT_EQ(make_strided_iterator(v, 0, 3).stride(), 3);
+    EXPECT_EQ(make_strided_iterator(span.subspan(4), 0, 2)[2], 9);
+    EXPECT_EQ(make_strided_iterator<1>(v).operator->(), v.data());
+}
+
+TEST(strided_iterator, ConstexprTest){
+    static int array[] { 1, 2, 3, 4, 5, 6 };
+    constexpr strided_iterator<int, 2> it = make_strided_iterator<2>(array, 1);
+    static_assert(it.operator->() == array + 1);
+    constexpr strided_iterator<int> it2 { std::span<int> { array }.begin(), 3 };
+    static_assert(it2.stride() == 3);
+    EXPECT_EQ(*it, 2);
+}
+#endif
\ No newline at end of file
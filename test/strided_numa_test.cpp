@@ -0,0 +1,89 @@
+/**
+ * @file strided_numa_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of numa_strided_buffer
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_numa.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(numa_topology, DetectTest){
+    numa_topology topology = numa_topology::detect();
+    EXPECT_GE(topology.node_count(), 1U);
+
+    EXPECT_THAT(numa_topology::parse_cpu_list("0-3,8,10-11\n"), ::testing::ElementsAreArray({ 0, 1, 2, 3, 8, 10, 11 }));
+    EXPECT_TRUE(numa_topology::parse_cpu_list("").empty());
+    EXPECT_THAT(numa_topology::parse_cpu_list("0,2\n"), ::testing::ElementsAreArray({ 0, 2 }));
+}
+
+TEST(numa_strided_buffer, PartitionTest){
+    // two fake nodes on whatever CPUs this machine has, so the partitioning is the same as on a dual-socket host
+    numa_topology topology = numa_topology::detect();
+    topology.node_cpus.push_back(topology.node_cpus.front());
+
+    numa_strided_buffer<float> buffer { 100000, 3, 4, topology };
+    ASSERT_EQ(buffer.partitions().size(), 4U);
+    EXPECT_EQ(buffer.size(), 300000U);
+
+    // partitions cover all records in order, and each starts with the first record at or after a page boundary (pages are at least 4 KiB,
+    // and a boundary of larger pages is one of 4 KiB pages too)
+    constexpr std::size_t page = 4096, record_bytes = 3 * sizeof(float);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer.data()) % page, 0U);
+    std::size_t next = 0;
+    for (const numa_partition& partition : buffer.partitions()){
+        EXPECT_EQ(partition.first, next);
+        EXPECT_LE(partition.first, partition.last);
+        if (partition.first != 0){
+            EXPECT_GT(partition.first * record_bytes / page * page, (partition.first - 1) * record_bytes);
+        }
+        next = partition.last;
+    }
+    EXPECT_EQ(next, buffer.records());
+    EXPECT_THAT(buffer.partitions(), ::testing::Each(::testing::Field(&numa_partition::node, ::testing::Lt(2U))));
+    EXPECT_EQ(buffer.partitions().front().node, 0U);
+    EXPECT_EQ(buffer.partitions().back().node, 1U);
+
+    // first touch value-initialized every element
+    EXPECT_TRUE(std::all_of(buffer.data(), buffer.data() + buffer.size(), [](float x){ return x == 0.f; }));
+}
+
+TEST(numa_strided_buffer, ParallelForTest){
+    numa_strided_buffer<int> buffer { 12345, 4 };
+
+    // fill channel 2 of each partition from its own worker, then sum it
+    buffer.parallel_for([&](const numa_partition& partition){
+        std::iota(buffer.channel_begin(partition, 2), buffer.channel_end(partition, 2), static_cast<int>(partition.first));
+    });
+
+    std::atomic<long long> sum { 0 };
+    const numa_strided_buffer<int>& const_buffer = buffer;
+    const_buffer.parallel_for([&](const numa_partition& partition){
+        sum += std::accumulate(const_buffer.channel_begin(partition, 2), const_buffer.channel_end(partition, 2), 0LL);
+    });
+    EXPECT_EQ(sum, 12344LL * 12345 / 2);
+
+    // other channels are untouched
+    EXPECT_EQ(std::count(buffer.data(), buffer.data() + buffer.size(), 0), 12345 * 3 + 1);
+}
+
+TEST(numa_strided_buffer, EmptyTest){
+    numa_strided_buffer<double> buffer { 0, 2, 3 };
+    EXPECT_EQ(buffer.size(), 0U);
+    EXPECT_EQ(buffer.partitions().size(), 3U);
+
+    numa_strided_buffer<double> moved = std::move(buffer);
+    EXPECT_EQ(moved.partitions().size(), 3U);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file strided_ring_buffer_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of strided_ring_buffer
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_ring_buffer.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(strided_ring_buffer, ReserveAcquireTest){
+    strided_ring_buffer<int> ring { 6, 3 }; // rounded up to 8 frames
+    EXPECT_EQ(ring.capacity(), 8U);
+    EXPECT_EQ(ring.channels(), 3U);
+    EXPECT_TRUE(ring.acquire().empty());
+
+    auto frames = ring.reserve(5);
+    ASSERT_EQ(frames.size(), 5U);
+    for (std::size_t f = 0; f < 5; ++f){
+        for (std::size_t c = 0; c < 3; ++c) frames(f, c) = static_cast<int>(10 * f + c);
+    }
+    ring.publish(5);
+    EXPECT_EQ(ring.size(), 5U);
+
+    // only 3 free frames left
+    EXPECT_EQ(ring.reserve(10).size(), 3U);
+
+    auto read = ring.acquire(2);
+    ASSERT_EQ(read.size(), 2U);
+    EXPECT_THAT(std::vector<int>(read.channel(1).begin(), read.channel(1).end()), ::testing::ElementsAre(1, 11));
+    ring.release(2);
+    EXPECT_EQ(ring.size(), 3U);
+    EXPECT_EQ(ring.reserve(10).size(), 5U);
+}
+
+TEST(strided_ring_buffer, WrapTest){
+    strided_ring_buffer<float> ring { 4, 2 };
+
+    // move the indices to frame 3, so the next 3 frames wrap around the end
+    ring.reserve(3);
+    ring.publish(3);
+    ring.acquire();
+    ring.release(3);
+
+    auto frames = ring.reserve(3);
+    ASSERT_EQ(frames.size(), 3U);
+    std::iota(frames.channel(0).begin(), frames.channel(0).end(), 1.f);
+    std::fill(frames.channel(1).begin(), frames.channel(1).end(), -1.f);
+    ring.publish(3);
+
+    const auto channel = ring.acquire().channel(0);
+    ASSERT_EQ(channel.size(), 3U);
+    EXPECT_THAT(std::vector<float>(channel.begin(), channel.end()), ::testing::ElementsAre(1.f, 2.f, 3.f));
+    EXPECT_EQ(channel.end() - channel.begin(), 3);
+    EXPECT_EQ(channel.begin()[2], 3.f);
+    EXPECT_LT(channel.begin(), channel.end());
+
+    // the wrap point splits the channel into two strided segments
+    const auto segments = channel.segments();
+    EXPECT_THAT(std::vector<float>(segments[0].begin(), segments[0].end()), ::testing::ElementsAre(1.f));
+    EXPECT_THAT(std::vector<float>(segments[1].begin(), segments[1].end()), ::testing::ElementsAre(2.f, 3.f));
+    EXPECT_EQ(segments[1].begin().stride(), 2);
+
+    // no wrap: a single segment
+    ring.release(1);
+    ring.acquire(1);
+    const auto unwrapped = ring.acquire(2).channel(1).segments();
+    EXPECT_EQ(unwrapped[0].size(), 2U);
+    EXPECT_TRUE(unwrapped[1].empty());
+}
+
+TEST(strided_ring_buffer, PushTest){
+    strided_ring_buffer<int> ring { 4, 2 };
+    const std::vector<int> frames { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    EXPECT_EQ(ring.push(frames.data(), 3), 3U);
+    ring.release(ring.acquire(2).size());
+    EXPECT_EQ(ring.push(frames.data(), 5), 3U); // wraps, and the ring is full after 3 frames
+
+    const auto channel = ring.acquire().channel(1);
+    EXPECT_THAT(std::vector<int>(channel.begin(), channel.end()), ::testing::ElementsAre(5, 1, 3, 5));
+}
+
+TEST(strided_ring_buffer, ThreadTest){
+    constexpr std::size_t channels = 3, total = 200000;
+    strided_ring_buffer<std::uint32_t> ring { 256, channels };
+
+    std::thread producer { [&]{
+        std::size_t produced = 0;
+        while (produced < total){
+            auto frames = ring.reserve(std::min<std::size_t>(37, total - produced));
+            if (frames.empty()){
+                // the ring is full, let the consumer run (on a single CPU it can't until this thread gives up its time slice)
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t c = 0; c < channels; ++c){
+                auto channel = frames.channel(c);
+                std::uint32_t value = static_cast<std::uint32_t>(produced * channels + c);
+                for (std::uint32_t& element : channel){
+                    element = value;
+                    value += channels;
+                }
+            }
+            ring.publish(frames.size());
+            produced += frames.size();
+        }
+    } };
+
+    std::size_t consumed = 0, errors = 0;
+    while (consumed < total){
+        const auto frames = ring.acquire(64);
+        if (frames.empty()){
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t c = 0; c < channels; ++c){
+            std::uint32_t expected = static_cast<std::uint32_t>(consumed * channels + c);
+            for (const auto& segment : frames.channel(c).segments()){
+                for (std::uint32_t element : segment){
+                    errors += element != expected;
+                    expected += channels;
+                }
+            }
+        }
+        ring.release(frames.size());
+        consumed += frames.size();
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, 0U);
+    EXPECT_EQ(ring.size(), 0U);
+}
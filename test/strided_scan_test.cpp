@@ -0,0 +1,102 @@
+/**
+ * @file strided_scan_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of strided_fused_scan
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_scan.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(strided_fused_scan, AllStatisticsTest){
+    // x y z records, z has nulls
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> xyz {
+        1, 10, 100,
+        2, 20, nan,
+        3, 30, 300,
+        4, 40, nan,
+        5, 50, 500,
+        6, 60, 600,
+        7, 70, 700,
+    };
+
+    auto [x, y, z] = strided_fused_scan<strided_statistic::all, strided_channel<0, 3>, strided_channel<1, 3>, strided_channel<2, 3>>(xyz.data(), 7);
+
+    EXPECT_EQ(x.min, 1);
+    EXPECT_EQ(x.max, 7);
+    EXPECT_DOUBLE_EQ(x.mean, 4);
+    EXPECT_DOUBLE_EQ(x.variance, 4);
+    EXPECT_EQ(x.count, 7U);
+    EXPECT_EQ(x.null_count, 0U);
+
+    EXPECT_EQ(y.min, 10);
+    EXPECT_EQ(y.max, 70);
+    EXPECT_DOUBLE_EQ(y.mean, 40);
+    EXPECT_DOUBLE_EQ(y.variance, 400);
+
+    EXPECT_EQ(z.min, 100);
+    EXPECT_EQ(z.max, 700);
+    EXPECT_DOUBLE_EQ(z.mean, 440);
+    EXPECT_DOUBLE_EQ(z.variance, (340.0 * 340 + 140 * 140 + 60 * 60 + 160 * 160 + 260 * 260) / 5);
+    EXPECT_EQ(z.count, 5U);
+    EXPECT_EQ(z.null_count, 2U);
+}
+
+TEST(strided_fused_scan, SelectedStatisticsTest){
+    std::vector<int> v(1000);
+    std::iota(v.begin(), v.end(), -500);
+
+    // even and odd elements, and the reversed sequence
+    auto results = strided_fused_scan<strided_statistic::min | strided_statistic::max, strided_channel<0, 2>, strided_channel<1, 2>, strided_channel<999, -1>>(v.data(), 500);
+    EXPECT_EQ(results[0].min, -500);
+    EXPECT_EQ(results[0].max, 498);
+    EXPECT_EQ(results[1].min, -499);
+    EXPECT_EQ(results[1].max, 499);
+    EXPECT_EQ(results[2].min, 0);
+    EXPECT_EQ(results[2].max, 499);
+
+    // not requested statistics are value-initialized
+    EXPECT_EQ(results[0].mean, 0);
+    EXPECT_EQ(results[0].variance, 0);
+    EXPECT_EQ(results[0].count, 500U);
+}
+
+TEST(strided_fused_scan, MatchesSeparatePassesTest){
+    constexpr std::size_t channels = 4, records = 1001;
+    std::vector<float> samples(channels * records);
+    for (std::size_t i = 0; i < samples.size(); ++i){
+        samples[i] = 1000.0f + static_cast<float>((i * 2654435761U) % 1000) / 7.0f;
+    }
+
+    auto results = strided_fused_scan<strided_statistic::mean | strided_statistic::variance, strided_channel<0, 4>, strided_channel<3, 4>>(samples.data(), records);
+    for (std::size_t c : { 0, 1 }){
+        const std::size_t offset = c == 0 ? 0 : 3;
+        const_strided_iterator<float> first { samples.data() + offset, 4 }, last { samples.data() + offset + samples.size(), 4 };
+
+        double mean = std::accumulate(first, last, 0.0) / records;
+        double variance = std::accumulate(first, last, 0.0, [=](double acc, float x){ return acc + (x - mean) * (x - mean); }) / records;
+        EXPECT_NEAR(results[c].mean, mean, 1e-9 * mean);
+        EXPECT_NEAR(results[c].variance, variance, 1e-9 * variance);
+    }
+}
+
+TEST(strided_fused_scan, EmptyTest){
+    std::vector<double> v;
+    auto [result] = strided_fused_scan<strided_statistic::all, strided_channel<0, 1>>(v.data(), 0);
+    EXPECT_EQ(result.count, 0U);
+    EXPECT_EQ(result.null_count, 0U);
+    EXPECT_TRUE(std::isnan(result.mean));
+}
@@ -0,0 +1,118 @@
+/**
+ * @file strided_transpose_test.hpp
+ * @author LEE KYOUNGHEON (stripe2933@outlook.com)
+ * @brief unit test of strided_transpose and strided_tiles
+ * @version 0.1
+ * @date 2022-05-06
+ *
+ * @copyright Copyright (c) 2022
+ * This code is licensed under MIT license (see LICENSE.txt for details)
+ */
+
+#include <strided_transpose.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+template <typename Tp>
+void expect_transposed(std::size_t rows, std::size_t cols, std::ptrdiff_t src_padding, std::ptrdiff_t dst_padding){
+    const std::ptrdiff_t src_stride = static_cast<std::ptrdiff_t>(cols) + src_padding, dst_stride = static_cast<std::ptrdiff_t>(rows) + dst_padding;
+    std::vector<Tp> src(rows * src_stride), dst(cols * dst_stride, Tp { -1 });
+    for (std::size_t i = 0; i < src.size(); ++i){
+        src[i] = static_cast<Tp>(i);
+    }
+
+    strided_transpose(src.data(), src_stride, dst.data(), dst_stride, rows, cols);
+    for (std::size_t i = 0; i < rows; ++i){
+        for (std::size_t j = 0; j < cols; ++j){
+            ASSERT_EQ(dst[j * dst_stride + i], src[i * src_stride + j]) << "at (" << i << ", " << j << ") of " << rows << "x" << cols;
+        }
+    }
+    // padding of the destination is untouched
+    for (std::size_t j = 0; j < cols; ++j){
+        for (std::ptrdiff_t i = static_cast<std::ptrdiff_t>(rows); i < dst_stride; ++i){
+            ASSERT_EQ(dst[j * dst_stride + i], Tp { -1 });
+        }
+    }
+}
+
+TEST(strided_transpose, TransposeTest){
+    for (auto [rows, cols] : std::vector<std::pair<std::size_t, std::size_t>> { { 1, 1 }, { 3, 5 }, { 8, 8 }, { 17, 9 }, { 64, 64 }, { 100, 37 }, { 129, 200 } }){
+        expect_transposed<float>(rows, cols, 0, 0);
+        expect_transposed<float>(rows, cols, 3, 1);
+        expect_transposed<double>(rows, cols, 1, 2);
+        expect_transposed<std::int32_t>(rows, cols, 0, 5);
+        expect_transposed<std::int64_t>(rows, cols, 0, 0);
+        expect_transposed<std::int16_t>(rows, cols, 2, 0);
+    }
+}
+
+TEST(strided_transpose, NonTriviallyCopyableTest){
+    std::vector<std::string> src { "a", "b", "c", "d", "e", "f" }, dst(6);
+    strided_transpose(src.data(), 3, dst.data(), 2, 2, 3);
+    EXPECT_THAT(dst, ::testing::ElementsAreArray({ "a", "d", "b", "e", "c", "f" }));
+}
+
+TEST(strided_tiles, TraversalTest){
+    // 5x7 region inside a matrix of width 10, with 2x3 tiles
+    std::vector<int> matrix(10 * 6);
+    std::iota(matrix.begin(), matrix.end(), 0);
+
+    std::vector<std::array<std::size_t, 4>> tiles;
+    std::vector<int> visited;
+    for (const strided_tile<int>& tile : strided_tiles(matrix.data() + 11, 10, 5, 7, 2, 3)){
+        tiles.push_back({ tile.row, tile.column, tile.rows, tile.columns });
+        for (std::size_t i = 0; i < tile.rows; ++i){
+            std::copy(tile.row_begin(i), tile.row_end(i), std::back_inserter(visited));
+        }
+    }
+    EXPECT_THAT(tiles, ::testing::ElementsAreArray(std::vector<std::array<std::size_t, 4>> {
+        { 0, 0, 2, 3 }, { 0, 3, 2, 3 }, { 0, 6, 2, 1 },
+        { 2, 0, 2, 3 }, { 2, 3, 2, 3 }, { 2, 6, 2, 1 },
+        { 4, 0, 1, 3 }, { 4, 3, 1, 3 }, { 4, 6, 1, 1 },
+    }));
+
+    // every element of the region is visited once
+    std::sort(visited.begin(), visited.end());
+    std::vector<int> expected;
+    for (int i = 1; i <= 5; ++i){
+        for (int j = 1; j <= 7; ++j){
+            expected.push_back(i * 10 + j);
+        }
+    }
+    EXPECT_EQ(visited, expected);
+
+    // columns of a tile
+    const strided_tile<int> tile = *std::next(strided_tiles(matrix.data() + 11, 10, 5, 7, 2, 3).begin(), 4);
+    std::vector<int> column(tile.column_begin(1), tile.column_end(1));
+    EXPECT_THAT(column, ::testing::ElementsAreArray({ 35, 45 }));
+
+    // tiles are returned by value, so they outlive the iterator
+    auto tile_iterator = strided_tiles(matrix.data() + 11, 10, 5, 7, 2, 3).begin();
+    const strided_tile<int> first_tile = *tile_iterator++;
+    EXPECT_EQ(first_tile.column, 0U);
+    EXPECT_EQ((*tile_iterator).column, 3U);
+#if __cplusplus > 201703L
+    constexpr auto is_forward_iterator = std::forward_iterator<strided_tile_iterator<int>>;
+    EXPECT_TRUE(is_forward_iterator);
+#endif
+
+    // empty regions have no tile
+    auto empty = strided_tiles(matrix.data(), 10, 0, 7);
+    EXPECT_TRUE(empty.begin() == empty.end());
+    auto empty2 = strided_tiles(matrix.data(), 10, 3, 0);
+    EXPECT_TRUE(empty2.begin() == empty2.end());
+}
+
+TEST(strided_tiles, TileSizeTest){
+    constexpr std::size_t float_tile = strided_tile_size<float>(), double_tile = strided_tile_size<double>();
+    EXPECT_EQ(float_tile % 16, 0U);
+    EXPECT_EQ(double_tile % 8, 0U);
+    EXPECT_LE(2 * float_tile * float_tile * sizeof(float), std::size_t { STRIDED_ITERATOR_L1_CACHE_SIZE });
+}